@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define ARENA_BLOCK_SIZE (1u << 20)    // Default block size
+#define ARENA_ALIGN      64            // Every allocation starts on a cache line
+
+// One heap block of an arena
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    size_t size;            // Usable bytes in data
+    size_t used;
+    unsigned char data[];
+} ArenaBlock;
+
+// Linear allocator for data that lives and dies together (one level).
+// Allocations are bump-pointer, there is no per-allocation free, and a
+// reset rewinds every block without returning it to the heap, so the same
+// sequence of allocations after a reset touches no heap at all.
+typedef struct {
+    ArenaBlock* blocks;     // In allocation order
+    ArenaBlock* current;    // Block the next allocation is tried in first
+    size_t blockSize;
+    size_t used;            // Bytes handed out since the last reset
+    size_t reserved;        // Bytes held in blocks
+    int blockCount;
+    void* last;             // Most recent allocation (for Arena_Shrink)
+} Arena;
+
+// Function declarations
+Arena* Arena_Create(size_t blockSize);
+void Arena_Destroy(Arena* arena);
+void* Arena_Alloc(Arena* arena, size_t size);
+void* Arena_Calloc(Arena* arena, size_t count, size_t size);
+void Arena_Shrink(Arena* arena, void* ptr, size_t size);
+void Arena_Reset(Arena* arena);
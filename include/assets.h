@@ -2,13 +2,49 @@
 
 #include "raylib.h"
 #include "maze.h"
+#include "procmaterial.h"
+#include "rng.h"
 #include <stdbool.h>
 
+#define ASSET_TEXTURE_SIZE 256   // Default procedural texture size (power of two tiles seamlessly)
+
+// Textures in GameAssets.timings
+typedef enum {
+    ASSET_TEXTURE_WALL,
+    ASSET_TEXTURE_FLOOR,
+    ASSET_TEXTURE_CEILING,
+    ASSET_TEXTURE_COUNT
+} AssetTexture;
+
+// How Assets_Load produces textures (the game's command line settings)
+typedef struct {
+    int textureSize;       // Width and height, 0 for ASSET_TEXTURE_SIZE
+    bool compress;         // Encode the mip chains to DXT1 on the CPU
+    const char* cacheDir;  // Texture cache directory, NULL to always generate
+    bool shaderMaterials;  // Evaluate the patterns in a shader instead (falls back to textures)
+} AssetSettings;
+
+// Where one texture's load time went
+typedef struct {
+    bool cacheHit;
+    double generateMs;     // Procedural fill (0 on a hit)
+    double encodeMs;       // Mip chain and compression (0 on a hit)
+    double cacheMs;        // Mapping the entry on a hit, storing it on a miss
+    double uploadMs;       // LoadTextureFromImage (a hit's pages are read here)
+} AssetLoadTiming;
+
+// Textures still being generated (assets.c)
+typedef struct AssetLoader AssetLoader;
+
 // Texture assets
 typedef struct {
     Texture2D wallTexture;
     Texture2D floorTexture;
     Texture2D ceilingTexture;
+    AssetLoadTiming timings[ASSET_TEXTURE_COUNT];  // Final once the texture is swapped in
+    AssetLoader* loader;   // NULL once every placeholder has been replaced
+    ProcMaterial material; // Used by the chunks when shaderMaterials is set
+    bool shaderMaterials;  // Textures stay placeholders and are never sampled
     bool loaded;
 } GameAssets;
 
@@ -38,23 +74,25 @@ typedef struct {
     Vector3 emitterPos;
     float emitRate;
     float emitAccumulator;
+    Rng rng;               // Private stream, so systems can update independently
 } ParticleSystem;
 
 // Function declarations
-GameAssets* Assets_Load(void);
+GameAssets* Assets_Load(uint64_t seed, const AssetSettings* settings);
+int Assets_Poll(GameAssets* assets);
+void Assets_Finish(GameAssets* assets);
 void Assets_Unload(GameAssets* assets);
-Texture2D GenerateStoneWallTexture(int width, int height);
-Texture2D GenerateWoodFloorTexture(int width, int height);
-Texture2D GenerateCeilingTexture(int width, int height);
+Texture2D GenerateStoneWallTexture(int width, int height, Rng* rng);
+Texture2D GenerateWoodFloorTexture(int width, int height, Rng* rng);
+Texture2D GenerateCeilingTexture(int width, int height, Rng* rng);
 
 // Torch functions
-int Torches_Generate(const Maze* maze, Torch** outTorches, int maxTorches);
+int Torches_Generate(const Maze* maze, const WallRect* walls, int wallCount, Torch* outTorches, int maxTorches, Rng* rng);
 void Torches_Update(Torch* torches, int count, float dt);
 void Torches_Render(const Torch* torches, int count);
 
 // Particle system functions
-ParticleSystem* ParticleSystem_Create(int maxParticles);
-void ParticleSystem_Destroy(ParticleSystem* ps);
+void ParticleSystem_Init(ParticleSystem* ps, Particle* particles, int maxParticles, Rng rng);
 void ParticleSystem_Update(ParticleSystem* ps, Vector3 emitterPos, float dt);
 void ParticleSystem_Render(const ParticleSystem* ps);
 
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "maze.h"
+#include <stdint.h>
+
+#define CHUNKED_MAZE_CHUNK 64   // Chunk edge length in cells
+#define CHUNKED_MAZE_CACHE 64   // Chunks kept in memory by default (64 x 4 KB)
+
+// Cache counters for the overlay / benchmarks
+typedef struct {
+    long long lookups;
+    long long generated;    // Chunks built (first use or after eviction)
+    long long evictions;
+    int resident;           // Chunks currently held
+} ChunkCacheStats;
+
+// Function declarations
+Maze* ChunkedMaze_Create(int width, int height, float cellSize, uint64_t seed, MazeAlgorithm algorithm);
+bool ChunkedMaze_Is(const Maze* maze);
+void ChunkedMaze_Prefetch(const Maze* maze, int cellX, int cellY, int radiusChunks);
+int ChunkedMaze_ChunkCount(const Maze* maze);
+bool ChunkedMaze_SetCacheChunks(Maze* maze, int chunks);
+ChunkCacheStats ChunkedMaze_GetStats(const Maze* maze);
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "maze.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define COMPRESSED_MAZE_BLOCK 64    // Block edge length in cells
+#define COMPRESSED_MAZE_CACHE 16    // Default decoded blocks kept in memory (16 x 4 KB)
+
+// Container and cache counters for the overlay / benchmarks
+typedef struct {
+    long long lookups;
+    long long decoded;          // Blocks decoded (first use or after eviction)
+    long long evictions;
+    int resident;               // Blocks currently decoded
+    size_t rawBytes;            // Packed 2-bit size of the same maze
+    size_t compressedBytes;     // Container size (header, index and blocks)
+} CompressedMazeStats;
+
+// Function declarations
+bool CompressedMaze_Save(const Maze* maze, const char* path);
+Maze* CompressedMaze_Open(const char* path, int cacheBlocks);
+bool CompressedMaze_Is(const Maze* maze);
+CompressedMazeStats CompressedMaze_GetStats(const Maze* maze);
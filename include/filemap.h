@@ -0,0 +1,10 @@
+#pragma once
+
+#include <stddef.h>
+
+// Whole-file views shared by the maze, level pack and texture cache
+// loaders. Where mmap exists the view is a private copy-on-write mapping
+// (writes never reach the file); elsewhere it is the file read into one
+// heap block, owned the same way.
+void* FileMap_Open(const char* path, size_t* outSize);
+void FileMap_Close(void* view, size_t size);
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "maze.h"
+#include <stdbool.h>
+
+// Pursuit field over the maze cell graph: for every cell, the MAZE_* direction
+// of the next step on a shortest path to the target cell. Built by one BFS and
+// shared by every chaser, so each chaser's move is a single lookup.
+typedef struct {
+    int width;
+    int height;
+    unsigned char* toward;  // Next-step direction per cell (0 at the target or if unreachable)
+    int* queue;             // BFS scratch, one entry per cell
+    int targetX, targetY;   // Cell the field currently points at
+    bool isTree;            // Perfect maze: moving the target only re-roots the tree
+    int rebuilds;           // Full BFS passes so far
+    int repairs;            // Incremental target moves so far
+} FlowField;
+
+// Function declarations
+FlowField* FlowField_Create(const Maze* maze);
+void FlowField_Destroy(FlowField* field);
+void FlowField_Build(FlowField* field, const Maze* maze, int targetX, int targetY);
+void FlowField_SetTarget(FlowField* field, const Maze* maze, int targetX, int targetY);
+int FlowField_Direction(const FlowField* field, int x, int y);
@@ -0,0 +1,6 @@
+#pragma once
+
+// Heap allocations (malloc, calloc, realloc) made so far by the calling
+// thread, counted in debug builds on glibc so the game can check that a
+// running level's frames never touch the heap. -1 where it is not counted.
+long long HeapCheck_Allocations(void);
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "arena.h"
+#include "maze.h"
+#include "assets.h"
+#include "mazemesh.h"
+#include "flowfield.h"
+#include "visibility.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// How a generated level is built (the game's command line settings)
+typedef struct {
+    int width, height;
+    float cellSize;
+    float wallHeight;
+    float wallThick;
+    MazeAlgorithm algorithm;
+    int generatorThreads;   // Maze_GenerateParallel threads, 0 = single pass
+    bool packed;            // MAZE_STORAGE_PACKED
+    int maxTorches;
+} LevelSettings;
+
+// Everything a level needs that can be built without the GPU. The level,
+// its maze, walls and torches live in the arena it was built in; the game
+// takes the heap-owned fields it wants (setting them to NULL) and destroys
+// the rest.
+typedef struct {
+    uint64_t seed;
+    Arena* arena;
+    Maze* maze;                 // Arena
+    WallRect* walls;            // Merged wall runs (arena)
+    int wallCount;
+    MazeMeshBake mesh;          // For MazeMesh_UploadOwned on the main thread
+    Torch* torches;             // Arena
+    int torchCount;
+    FlowField* flowField;       // Rooted at the start cell
+    PortalCuller* portalCuller;
+    VisibleSet* visibleCells;
+    double buildSeconds;
+} Level;
+
+// A level being built on a worker thread
+typedef struct LevelPrefetch LevelPrefetch;
+
+// Function declarations
+Level* Level_Build(const LevelSettings* settings, uint64_t seed, Arena* arena);
+void Level_Destroy(Level* level);
+
+LevelPrefetch* LevelPrefetch_Start(const LevelSettings* settings, uint64_t seed, Arena* arena);
+bool LevelPrefetch_IsReady(LevelPrefetch* prefetch);
+Level* LevelPrefetch_Finish(LevelPrefetch* prefetch);
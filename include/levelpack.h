@@ -0,0 +1,31 @@
+#pragma once
+
+#include "maze.h"
+#include "assets.h"
+#include "mazemesh.h"
+#include "visibility.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define LEVEL_PACK_MAGIC   "MLVL"
+#define LEVEL_PACK_VERSION 1
+
+// Everything a level needs besides the maze, baked offline (tools/mazebake).
+// A pack is a maze file with these sections appended after the maze, so
+// Maze_Map also opens it; the arrays point into the maze's file mapping
+// and stay valid until the maze is destroyed.
+typedef struct {
+    float wallHeight;
+    float wallThick;
+    const WallRect* walls;      // Merged wall runs (Maze_GetMergedWallRects)
+    int wallCount;
+    MazeMeshBake mesh;          // Chunked wall geometry for MazeMesh_Upload
+    Pvs pvs;                    // Borrowed arrays; width 0 if the pack has none
+    const Torch* torches;
+    int torchCount;
+} LevelPack;
+
+// Function declarations
+bool LevelPack_Bake(const Maze* maze, const char* path, float wallHeight, float wallThick, int maxTorches,
+                    bool withPvs);
+Maze* LevelPack_Open(const char* path, LevelPack* outPack);
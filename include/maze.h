@@ -1,7 +1,11 @@
 #pragma once
 
 #include "raylib.h"
+#include "rng.h"
+#include "arena.h"
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 // Maze cell directions (bit flags for walls)
 #define MAZE_NORTH 0x01
@@ -10,28 +14,150 @@
 #define MAZE_WEST  0x08
 #define MAZE_ALL   0x0F
 
+// Cell storage layouts (see Maze_CreateEx)
+typedef enum {
+    MAZE_STORAGE_BYTES,     // One byte of MAZE_* flags per cell, row-major
+    MAZE_STORAGE_PACKED,    // Four cells per byte: each stores only its NORTH and WEST
+                            // edge; EAST/SOUTH come from the neighbour, borders are walls
+    MAZE_STORAGE_TILED,     // One byte per cell in 8x8 tiles (a cache line each)
+    MAZE_STORAGE_MORTON     // One byte per cell, Z-order inside 64x64 tiles (a page each)
+} MazeStorage;
+
+// Packed storage: 2 bits per cell, (x & 3) picks the pair within a byte and
+// every row starts on a byte boundary
+#define MAZE_PACKED_NORTH 0x1
+#define MAZE_PACKED_WEST  0x2
+#define MAZE_PACKED_STRIDE(width) (((size_t)(width) + 3) / 4)   // Bytes per row
+
+// Storage backend for mazes that are not held in one cells array (chunked,
+// file-backed). getCell returns the MAZE_* wall flags of an in-bounds
+// cell; destroy releases user when the maze is destroyed. hasWall is
+// optional and answers one wall of an in-bounds cell, for backends where a
+// whole cell costs more than one edge.
+typedef struct {
+    unsigned char (*getCell)(void* user, int x, int y);
+    void (*destroy)(void* user);
+    void* user;
+    bool (*hasWall)(void* user, int x, int y, int direction);
+} MazeSource;
+
 // Maze structure
 typedef struct {
     int width;          // Number of cells horizontally
     int height;         // Number of cells vertically
-    unsigned char* cells; // Cell data: each byte stores wall flags
+    unsigned char* cells; // Cell data: each byte stores wall flags (NULL when packed or source-backed)
+    MazeStorage storage;  // Layout of cells/edges (index with Maze_CellOffset)
+    unsigned char* edges; // Packed storage: 2 bits per cell, own NORTH/WEST edges (NULL otherwise)
+    MazeSource source;  // Backend answering wall queries when cells and edges are NULL
     float cellSize;     // Size of each cell in world units
     Vector2 startPos;   // Starting position (cell coordinates)
     Vector2 exitPos;    // Exit position (cell coordinates)
+    uint64_t seed;      // Level seed the maze was generated from (0 if unknown)
+    void* mapping;      // File view backing cells/edges (Maze_Map), NULL if heap-owned
+    size_t mappingSize;
+    bool borrowed;      // Struct and storage belong to an arena (Maze_CreateIn)
 } Maze;
 
+// Binary maze file (Maze_Save / Maze_Map): a MazeFileHeader, then the raw
+// cells or edges array at MAZE_FILE_ALIGN so a file mapping can back the
+// maze directly. All fields are little-endian.
+#define MAZE_FILE_MAGIC   "MAZE"
+#define MAZE_FILE_VERSION 1
+#define MAZE_FILE_ALIGN   4096  // Payload offset (page aligned)
+
+typedef struct {
+    char magic[4];          // MAZE_FILE_MAGIC
+    uint32_t version;       // MAZE_FILE_VERSION
+    uint32_t width, height;
+    uint32_t storage;       // MazeStorage of the payload
+    float cellSize;
+    float startX, startY;
+    float exitX, exitY;
+    uint64_t seed;
+    uint64_t payloadOffset; // From the start of the file
+    uint64_t payloadSize;   // Maze_StorageSize bytes
+} MazeFileHeader;
+
+// Byte offset of in-bounds cell (x, y) in cells for the maze's layout.
+// Tiled layouts keep vertical neighbours close together, which row-major
+// order does not once a row is wider than the cache.
+static inline size_t Maze_CellOffset(const Maze* maze, int x, int y) {
+    switch (maze->storage) {
+        case MAZE_STORAGE_TILED: {
+            size_t tilesX = ((size_t)maze->width + 7) >> 3;
+            return (((size_t)(y >> 3) * tilesX + (size_t)(x >> 3)) << 6) | (size_t)((y & 7) << 3 | (x & 7));
+        }
+        case MAZE_STORAGE_MORTON: {
+            // Interleave the low 6 bits of x and y (x in the even bits)
+            size_t tilesX = ((size_t)maze->width + 63) >> 6;
+            unsigned int z = (unsigned int)(x & 63) | (unsigned int)(y & 63) << 16;
+            z = (z | z << 4) & 0x0F0F0F0Fu;
+            z = (z | z << 2) & 0x33333333u;
+            z = (z | z << 1) & 0x55555555u;
+            return (((size_t)(y >> 6) * tilesX + (size_t)(x >> 6)) << 12) | (size_t)((z | z >> 15) & 0xFFFu);
+        }
+        default:
+            return (size_t)y * maze->width + x;
+    }
+}
+
+// Exposed end faces of a wall run
+#define WALL_CAP_START 0x01
+#define WALL_CAP_END   0x02
+
 // Wall rectangle for collision detection
 typedef struct {
     Rectangle rect;     // Collision rectangle in XZ plane
-    bool isVertical;    // true for N/S walls, false for E/W walls
+    bool isVertical;    // true for walls running along Z (W/E edges), false along X (N/S edges)
+    int x, y;           // Lattice start: north-west corner of cell (x, y)
+    int length;         // Length of the run in cells
+    unsigned char caps; // WALL_CAP_* flags for ends not covered by a perpendicular wall
 } WallRect;
 
+// Maze generation algorithms (see Maze_GenerateWith)
+typedef enum {
+    MAZE_ALGO_BACKTRACKER,  // Iterative DFS: long winding corridors
+    MAZE_ALGO_ELLER,        // Row at a time, O(width) memory, streamable
+    MAZE_ALGO_KRUSKAL,      // Random edge order with union-find
+    MAZE_ALGO_WILSON,       // Loop-erased random walks: uniform spanning tree
+    MAZE_ALGO_COUNT
+} MazeAlgorithm;
+
+#define MAZE_PARALLEL_TILE 512  // Default tile edge for Maze_GenerateParallel
+
+// Receives finished rows from a streaming generator (MAZE_* flags per cell)
+typedef void (*MazeRowSink)(void* user, int y, const unsigned char* row);
+
 // Function declarations
 Maze* Maze_Create(int width, int height, float cellSize);
+Maze* Maze_CreateEx(int width, int height, float cellSize, MazeStorage storage);
+Maze* Maze_CreateIn(Arena* arena, int width, int height, float cellSize, MazeStorage storage);
+Maze* Maze_CreateWithSource(int width, int height, float cellSize, MazeSource source);
 void Maze_Destroy(Maze* maze);
-void Maze_Generate(Maze* maze);
+size_t Maze_StorageSize(const Maze* maze);
+bool Maze_Save(const Maze* maze, const char* path);
+Maze* Maze_Map(const char* path);
+bool Maze_ReadFileHeader(const char* path, MazeFileHeader* outHeader);
+bool Maze_GenerateToFile(const char* path, int width, int height, float cellSize, uint64_t seed);
+void Maze_Unmap(Maze* maze);
+void Maze_Reset(Maze* maze);
+void Maze_SetRow(Maze* maze, int y, int x0, int count, const unsigned char* flags);
+bool Maze_RemoveWall(Maze* maze, int x, int y, int direction);
+void Maze_Generate(Maze* maze, Rng* rng);
+bool Maze_GenerateWith(Maze* maze, MazeAlgorithm algorithm, Rng* rng);
+size_t Maze_GenerateScratchSize(int width, int height, MazeStorage storage, MazeAlgorithm algorithm);
+bool Maze_GenerateInto(Maze* maze, MazeAlgorithm algorithm, Rng* rng, void* scratch, size_t scratchSize);
+bool Maze_StreamEller(int width, int height, Rng* rng, MazeRowSink sink, void* user);
+bool Maze_GenerateParallel(Maze* maze, MazeAlgorithm algorithm, Rng* rng, int threadCount, int tileSize);
+bool Maze_IsPerfect(const Maze* maze);
+int Maze_HardwareThreads(void);
+const char* Maze_AlgorithmName(MazeAlgorithm algorithm);
+bool Maze_AlgorithmFromName(const char* name, MazeAlgorithm* outAlgorithm);
 bool Maze_HasWall(const Maze* maze, int x, int y, int direction);
+unsigned char Maze_GetCell(const Maze* maze, int x, int y);
 int Maze_GetWallRects(const Maze* maze, WallRect* outRects, int maxRects);
+int Maze_GetMergedWallRects(const Maze* maze, WallRect* outRects, int maxRects);
+bool Maze_CollidesCircle(const Maze* maze, Vector2 center, float radius);
 Vector2 Maze_CellToWorld(const Maze* maze, int cellX, int cellY);
 void Maze_WorldToCell(const Maze* maze, float worldX, float worldZ, int* outCellX, int* outCellY);
 bool Maze_IsExit(const Maze* maze, int cellX, int cellY);
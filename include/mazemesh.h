@@ -0,0 +1,87 @@
+#pragma once
+
+#include "raylib.h"
+#include "maze.h"
+#include "visibility.h"
+
+#define MAZE_CHUNK_CELLS 16     // Chunk edge length in cells
+
+// One square region of the maze with its own baked geometry. A 16x16 chunk
+// always fits a single mesh with 16-bit indices.
+typedef struct {
+    Model walls;                    // Wall pieces in this chunk (meshCount 0 if none)
+    Model floor;
+    Model ceiling;
+    BoundingBox bounds;
+    int firstWall;                  // First wall piece stored in this chunk
+    int wallCount;
+    unsigned short* visibleIndices; // Scratch index list for culled draws
+    int visibleIndexCount;
+    unsigned int visibleStamp;      // == frame when a visible cell lies inside
+    bool partial;                   // GPU index buffer holds a culled subset
+} MazeMeshChunk;
+
+// Ranges of one chunk inside a MazeMeshBake
+typedef struct {
+    int firstWall;      // Wall pieces [firstWall, firstWall + wallCount)
+    int wallCount;
+    int firstQuad;      // Wall quads [firstQuad, firstQuad + quadCount)
+    int quadCount;
+} MazeMeshBakeChunk;
+
+// CPU half of a mesh build in flat arrays, so a level pack can store it as
+// is and MazeMesh_Upload can send it to the GPU without recomputing it.
+// Indices are local to their chunk's quads.
+typedef struct {
+    int width, height;          // Maze size in cells
+    int chunkCount;
+    int pieceCount;             // Wall pieces after cutting runs at chunk borders
+    int quadCount;              // Wall quads after hidden-face removal
+    MazeMeshBakeChunk* chunks;
+    int* wallChunk;             // Per wall piece: chunk it lives in
+    int* wallFirstIndex;        // Per wall piece: first index inside its chunk
+    unsigned char* wallIndexCount;
+    int* horizontalEdgeWall;    // width * (height + 1) lattice edges
+    int* verticalEdgeWall;      // (width + 1) * height lattice edges
+    float* vertices;            // 4 xyz per quad
+    float* texcoords;           // 4 uv per quad
+    unsigned short* indices;    // 6 per quad
+} MazeMeshBake;
+
+// Static maze geometry split into chunks. Merged wall runs are cut at chunk
+// borders so every piece lives in exactly one chunk.
+typedef struct {
+    MazeMeshChunk* chunks;
+    int chunkCount;
+    int chunksX, chunksY;
+    int width, height;      // Maze size in cells
+    int* wallChunk;         // Per wall piece: chunk it lives in
+    int* wallFirstIndex;    // Per wall piece: first index inside its chunk mesh
+    unsigned char* wallIndexCount;
+    int* horizontalEdgeWall; // Wall piece on each horizontal lattice edge (-1 if open)
+    int* verticalEdgeWall;   // Wall piece on each vertical lattice edge (-1 if open)
+    unsigned int* wallStamp; // Per wall piece: last frame it was gathered
+    unsigned int frame;
+    int wallCount;      // Number of wall pieces baked into the chunks
+    int faceCount;      // Number of wall quads after hidden-face removal
+    int drawCalls;      // Draw calls issued by the last draw
+    int drawnFaces;     // Wall quads submitted by the last draw
+    int drawnChunks;    // Chunks that passed culling in the last draw
+    bool borrowed;      // Lookup tables belong to a bake (e.g. a level pack), not the mesh
+} MazeMesh;
+
+// Function declarations
+MazeMesh* MazeMesh_Build(const Maze* maze, const WallRect* walls, int wallCount,
+                         float wallHeight, float wallThick,
+                         Texture2D wallTexture, Texture2D floorTexture, Texture2D ceilingTexture);
+bool MazeMesh_Bake(const Maze* maze, const WallRect* walls, int wallCount, float wallHeight, float wallThick,
+                   MazeMeshBake* outBake);
+void MazeMesh_FreeBake(MazeMeshBake* bake);
+MazeMesh* MazeMesh_Upload(const MazeMeshBake* bake, const Maze* maze, float wallHeight, float wallThick,
+                          Texture2D wallTexture, Texture2D floorTexture, Texture2D ceilingTexture);
+MazeMesh* MazeMesh_UploadOwned(MazeMeshBake* bake, const Maze* maze, float wallHeight, float wallThick,
+                               Texture2D wallTexture, Texture2D floorTexture, Texture2D ceilingTexture);
+void MazeMesh_SetTextures(MazeMesh* mesh, Texture2D wallTexture, Texture2D floorTexture, Texture2D ceilingTexture);
+void MazeMesh_SetShader(MazeMesh* mesh, Shader shader);
+void MazeMesh_Destroy(MazeMesh* mesh);
+void MazeMesh_Draw(MazeMesh* mesh, const Frustum* frustum, const VisibleSet* visible);
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "maze.h"
+#include <stddef.h>
+
+#define MAZE_WINDOW_BANDS 4     // Row bands mapped at once
+
+// Paging counters for the overlay / benchmarks
+typedef struct {
+    long long lookups;
+    long long remaps;       // Bands mapped (first touch or after eviction)
+    int bandRows;           // Rows per band
+    size_t bandBytes;       // Payload bytes per band
+    int resident;           // Bands currently mapped
+} MazeWindowStats;
+
+// Function declarations
+Maze* MazeWindow_Map(const char* path, size_t windowBytes);
+bool MazeWindow_Is(const Maze* maze);
+MazeWindowStats MazeWindow_GetStats(const Maze* maze);
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "raylib.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Stone walls, wood floors and plaster ceilings evaluated per fragment
+// from world position: the ProcTex_Fill patterns at the same scale, with no
+// texture memory and no tile repeats. The chunk models share the shader.
+typedef struct {
+    Shader shader;
+    int cellSizeLoc;
+    int wallHeightLoc;
+    int seedLoc;
+} ProcMaterial;
+
+// Function declarations
+bool ProcMaterial_Load(ProcMaterial* material, uint32_t seed);
+void ProcMaterial_SetScale(const ProcMaterial* material, float cellSize, float wallHeight);
+void ProcMaterial_Unload(ProcMaterial* material);
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "raylib.h"
+#include <stdint.h>
+
+// Procedural texture patterns (see ProcTex_Fill)
+typedef enum {
+    PROCTEX_STONE,      // Stone blocks in an 8x8 grid with mortar lines
+    PROCTEX_WOOD,       // Four planks with sine grain and streaky noise
+    PROCTEX_CEILING,    // Plaster with faint low-frequency noise
+    PROCTEX_COUNT
+} ProcTexPattern;
+
+#define PROCTEX_VERSION   1     // Bump when any pattern's pixels change (invalidates cached textures)
+#define PROCTEX_BAND_ROWS 32    // Rows per unit of work handed to a thread
+
+// Function declarations
+void ProcTex_Fill(Color* pixels, int width, int height, ProcTexPattern pattern, uint32_t seed, int threadCount);
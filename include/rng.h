@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stdint.h>
+
+// PCG32 random number generator. Every subsystem (and every worker thread)
+// owns its own Rng, derived from one master seed, so results are reproducible
+// and no generator is shared between threads.
+typedef struct {
+    uint64_t state;
+    uint64_t inc;       // Stream selector (always odd)
+} Rng;
+
+// Subsystem streams derived from the master seed
+typedef enum {
+    RNG_STREAM_MAZE = 1,
+    RNG_STREAM_TORCHES,
+    RNG_STREAM_CHASERS,
+    RNG_STREAM_PARTICLES,
+    RNG_STREAM_TEXTURE_WALL,
+    RNG_STREAM_TEXTURE_FLOOR,
+    RNG_STREAM_TEXTURE_CEILING,
+    RNG_STREAM_MATERIALS
+} RngStream;
+
+// Function declarations
+void Rng_Seed(Rng* rng, uint64_t seed, uint64_t stream);
+Rng Rng_ForStream(uint64_t masterSeed, RngStream stream, uint64_t index);
+uint64_t Rng_Mix(uint64_t a, uint64_t b);
+
+// Next 32 random bits
+static inline uint32_t Rng_Next(Rng* rng) {
+    uint64_t old = rng->state;
+    rng->state = old * 6364136223846793005ULL + rng->inc;
+    uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+    uint32_t rot = (uint32_t)(old >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31u));
+}
+
+// Uniform integer in [0, n) using a multiply-shift instead of a modulo
+static inline uint32_t Rng_Range(Rng* rng, uint32_t n) {
+    return (uint32_t)(((uint64_t)Rng_Next(rng) * n) >> 32);
+}
+
+// Uniform float in [0, 1)
+static inline float Rng_Float(Rng* rng) {
+    return (float)(Rng_Next(rng) >> 8) * (1.0f / 16777216.0f);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "raylib.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// On-disk cache of generated images. Entries are named after a key hashed
+// from everything that determines the pixels, so a changed generator,
+// parameter, size or seed simply misses and writes a new entry.
+#define TEXTURE_CACHE_DIR     "texcache"   // Default directory (relative to the working directory)
+#define TEXTURE_CACHE_MAGIC   "MTEX"
+#define TEXTURE_CACHE_VERSION 1
+#define TEXTURE_CACHE_ALIGN   4096         // Pixel data offset (page aligned)
+
+// Cache entry file: this header, then the pixel data of every mip level
+// back to back at TEXTURE_CACHE_ALIGN, exactly as raylib's Image holds it,
+// so a mapping of the file can be handed to LoadTextureFromImage as is
+typedef struct {
+    char magic[4];          // TEXTURE_CACHE_MAGIC
+    uint32_t version;       // TEXTURE_CACHE_VERSION
+    uint64_t key;           // TexCache_Key the entry was stored under
+    uint32_t width;
+    uint32_t height;
+    uint32_t format;        // PixelFormat
+    uint32_t mipmaps;       // Levels stored, 1 = base image only
+    uint64_t dataOffset;
+    uint64_t dataSize;
+} TextureCacheHeader;
+
+// A cache hit: image.data points into the mapped file until TexCache_Close
+typedef struct {
+    Image image;
+    void* mapping;
+    size_t mappingSize;
+} TextureCacheEntry;
+
+// Function declarations
+uint64_t TexCache_Key(const char* generator, const void* params, size_t paramsSize, int width, int height,
+                      uint64_t seed);
+bool TexCache_Open(const char* dir, uint64_t key, TextureCacheEntry* outEntry);
+void TexCache_Close(TextureCacheEntry* entry);
+bool TexCache_Store(const char* dir, uint64_t key, const Image* image);
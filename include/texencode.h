@@ -0,0 +1,13 @@
+#pragma once
+
+#include "raylib.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TEXENCODE_VERSION 1     // Bump when mip filtering or block encoding output changes
+
+// Function declarations
+uint64_t TexEncode_DataSize(int width, int height, int format, int mipmaps);
+bool TexEncode_Mipmaps(Image* image);
+bool TexEncode_DXT1(Image* image, int threadCount);
+Image TexEncode_DecodeDXT1(const Image* image);
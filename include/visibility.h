@@ -0,0 +1,73 @@
+#pragma once
+
+#include "maze.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Cells to draw this frame. Membership is a per-cell frame stamp, so clearing
+// the set and testing a cell are both O(1).
+typedef struct {
+    int width;
+    int height;
+    int* cells;             // Visible cell indices (y * width + x)
+    int count;
+    unsigned int* stamp;    // stamp[cell] == frame when the cell is in the set
+    unsigned int frame;
+} VisibleSet;
+
+// Precomputed potentially-visible set: for every cell, a bitset of the cells
+// that can be seen from anywhere inside it, clipped to their bounding box
+typedef struct {
+    int width;
+    int height;
+    int* boxes;             // Per cell: x0, y0, w, h of the visible bounding box
+    size_t* bitOffsets;     // Per cell: first bit of its bitset in bits[]
+    uint32_t* bits;
+    size_t bitCount;
+    long long totalVisible; // Sum of PVS sizes (for the average)
+    double buildSeconds;
+    bool borrowed;          // Arrays in a level pack mapping, struct in a level arena (Pvs_Destroy skips it)
+} Pvs;
+
+// Runtime portal traversal from the camera cell. Works on the live maze, so
+// it needs no precomputation and stays valid when walls change.
+typedef struct {
+    const Maze* maze;
+    struct PortalFrame* stack;  // Traversal scratch, grown on demand
+    int stackCapacity;
+    struct PortalSeen* seen;    // (cell, entry side) -> widest view pushed there, open addressing
+    int seenCapacity;           // Power of two, grown on demand
+    int seenCount;
+    unsigned int gather;        // Stamp of the current gather in seen[]
+    int visited;                // Cells entered by the last gather
+    int drawn;                  // Distinct cells it returned
+} PortalCuller;
+
+// Camera view volume as inward-facing planes through the eye (four sides
+// plus near), with a far plane at raylib's default cull distance
+typedef struct {
+    Vector3 eye;
+    Vector3 normals[6];
+    float farDistance;
+} Frustum;
+
+// Function declarations
+VisibleSet* VisibleSet_Create(const Maze* maze);
+void VisibleSet_Destroy(VisibleSet* set);
+void VisibleSet_Clear(VisibleSet* set);
+void VisibleSet_Add(VisibleSet* set, int x, int y);
+bool VisibleSet_Contains(const VisibleSet* set, int x, int y);
+
+Pvs* Pvs_Build(const Maze* maze);
+void Pvs_Destroy(Pvs* pvs);
+void Pvs_Gather(const Pvs* pvs, int x, int y, VisibleSet* out);
+float Pvs_AverageSize(const Pvs* pvs);
+
+PortalCuller* PortalCuller_Create(const Maze* maze);
+void PortalCuller_Destroy(PortalCuller* culler);
+bool PortalCuller_Gather(PortalCuller* culler, Vector3 eye, Vector3 forward, float fovy, float aspect,
+                         VisibleSet* out);
+
+Frustum Frustum_FromCamera(Camera3D camera, float aspect);
+bool Frustum_ContainsBox(const Frustum* frustum, BoundingBox box);
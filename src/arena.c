@@ -0,0 +1,106 @@
+#include "../include/arena.h"
+#include "raylib.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Helper: Offset of the next aligned allocation in a block
+static size_t AlignedOffset(const ArenaBlock* block) {
+    uintptr_t base = (uintptr_t)block->data;
+    uintptr_t next = (base + block->used + (ARENA_ALIGN - 1)) & ~(uintptr_t)(ARENA_ALIGN - 1);
+    return (size_t)(next - base);
+}
+
+// Create an empty arena; blocks of blockSize bytes (0 for the default) are
+// allocated as it fills, larger requests get a block of their own
+Arena* Arena_Create(size_t blockSize) {
+    Arena* arena = (Arena*)calloc(1, sizeof(Arena));
+    if (!arena) return NULL;
+    arena->blockSize = blockSize > 0 ? blockSize : ARENA_BLOCK_SIZE;
+    return arena;
+}
+
+// Free every block and the arena
+void Arena_Destroy(Arena* arena) {
+    if (!arena) return;
+    ArenaBlock* block = arena->blocks;
+    while (block) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    free(arena);
+}
+
+// Allocate size bytes (uninitialized, ARENA_ALIGN aligned). Blocks are
+// tried in order from the current one; a block too small for the request
+// keeps its tail unused until the next reset.
+void* Arena_Alloc(Arena* arena, size_t size) {
+    if (!arena) return NULL;
+    if (size == 0) size = 1;
+
+    ArenaBlock* tail = NULL;
+    for (ArenaBlock* block = arena->current; block; block = block->next) {
+        size_t offset = AlignedOffset(block);
+        if (offset <= block->size && size <= block->size - offset) {
+            block->used = offset + size;
+            arena->current = block;
+            arena->used += size;
+            arena->last = block->data + offset;
+            return arena->last;
+        }
+        tail = block;
+    }
+
+    // Nothing left fits: add a block at the end
+    if (size > SIZE_MAX - sizeof(ArenaBlock) - ARENA_ALIGN) return NULL;
+    size_t blockSize = size + ARENA_ALIGN > arena->blockSize ? size + ARENA_ALIGN : arena->blockSize;
+    ArenaBlock* block = (ArenaBlock*)malloc(sizeof(ArenaBlock) + blockSize);
+    if (!block) {
+        TraceLog(LOG_WARNING, "Arena out of memory allocating %zu bytes", size);
+        return NULL;
+    }
+    block->next = NULL;
+    block->size = blockSize;
+    block->used = 0;
+    if (tail) tail->next = block;
+    else arena->blocks = block;
+    arena->blockCount++;
+    arena->reserved += blockSize;
+
+    size_t offset = AlignedOffset(block);
+    block->used = offset + size;
+    arena->current = block;
+    arena->used += size;
+    arena->last = block->data + offset;
+    return arena->last;
+}
+
+// Allocate count zeroed elements (blocks are reused dirty after a reset)
+void* Arena_Calloc(Arena* arena, size_t count, size_t size) {
+    if (size > 0 && count > SIZE_MAX / size) return NULL;
+    void* ptr = Arena_Alloc(arena, count * size);
+    if (ptr) memset(ptr, 0, count * size);
+    return ptr;
+}
+
+// Give back the end of the most recent allocation, e.g. a buffer sized
+// for the worst case once the real count is known. Other pointers are
+// left alone.
+void Arena_Shrink(Arena* arena, void* ptr, size_t size) {
+    if (!arena || !ptr || ptr != arena->last) return;
+    ArenaBlock* block = arena->current;
+    size_t offset = (size_t)((unsigned char*)ptr - block->data);
+    if (offset + size >= block->used) return;
+    arena->used -= block->used - (offset + size);
+    block->used = offset + size;
+}
+
+// Forget every allocation at once; the blocks stay for the next level
+void Arena_Reset(Arena* arena) {
+    if (!arena) return;
+    for (ArenaBlock* block = arena->blocks; block; block = block->next) block->used = 0;
+    arena->current = arena->blocks;
+    arena->used = 0;
+    arena->last = NULL;
+}
@@ -1,118 +1,275 @@
 #include "../include/assets.h"
 #include "../include/maze.h"
-#include <stdlib.h>
+#include "../include/proctex.h"
+#include "../include/texcache.h"
+#include "../include/texencode.h"
 #include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
 #include <string.h>
 
-Texture2D GenerateStoneWallTexture(int width, int height) {
-    Image img = GenImageColor(width, height, (Color){80, 80, 85, 255});
-    
-    // access the pixel data directly
-    Color* pixels = (Color*)img.data;
-    
-    // add the stone-like noise and variation
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            int gridX = x % 32;
-            int gridY = y % 32;
-            bool isMortar = (gridX < 2 || gridY < 2 || gridX > 30 || gridY > 30);
-            
-            if (isMortar) {
-                pixels[y * width + x] = (Color){50, 50, 55, 255};
-            } else {
-                // Add noise for stone texture
-                float noise = ((float)(rand() % 100) / 100.0f) * 0.3f;
-                int baseR = 80 + (int)(noise * 40);
-                int baseG = 80 + (int)(noise * 30);
-                int baseB = 85 + (int)(noise * 25);
-                pixels[y * width + x] = (Color){baseR, baseG, baseB, 255};
-            }
-        }
+// Parameter block hashed into a procedural texture's cache key
+typedef struct {
+    uint32_t version;       // PROCTEX_VERSION
+    uint32_t pattern;
+    uint32_t encoder;       // TEXENCODE_VERSION
+    uint32_t compressed;
+} ProcTexKeyParams;
+
+// One texture on its way to the GPU: the CPU half runs anywhere, the
+// upload on the main thread
+typedef struct {
+    int width, height;
+    ProcTexPattern pattern;
+    uint32_t seed;
+    bool compress;              // DXT1-encode the mip chain
+    const char* cacheDir;
+    Image image;                // Generated pixels (owned) or a view of the cache entry
+    TextureCacheEntry entry;    // Mapping behind image on a cache hit
+    AssetLoadTiming timing;
+    atomic_bool ready;          // Published by the worker once image is complete
+} TextureJob;
+
+// Textures generated on a worker thread (Assets_Load / Assets_Poll)
+struct AssetLoader {
+    pthread_t thread;
+    bool threaded;
+    atomic_bool cancel;         // Set by Assets_Unload; the worker stops after its current texture
+    int next;                   // First texture not uploaded yet, in AssetTexture order
+    TextureJob jobs[ASSET_TEXTURE_COUNT];
+};
+
+// Helper: CPU half of a texture: a cached copy if there is one, else
+// generate the pattern, build its mip chain, optionally compress it and
+// store it in the cache. The fill and the encoder run on every hardware
+// thread.
+static void PrepareTexture(TextureJob* job) {
+    AssetLoadTiming* timing = &job->timing;
+    *timing = (AssetLoadTiming){0};
+
+    const ProcTexKeyParams params = {PROCTEX_VERSION, (uint32_t)job->pattern, TEXENCODE_VERSION, job->compress};
+    const uint64_t key = TexCache_Key("proctex", &params, sizeof(params), job->width, job->height, job->seed);
+
+    double start = GetTime();
+    if (job->cacheDir && TexCache_Open(job->cacheDir, key, &job->entry)) {
+        job->image = job->entry.image;
+        timing->cacheHit = true;
+        timing->cacheMs = (GetTime() - start) * 1000.0;
+        return;
+    }
+
+    job->entry = (TextureCacheEntry){0};
+    job->image = GenImageColor(job->width, job->height, BLANK);
+    ProcTex_Fill((Color*)job->image.data, job->width, job->height, job->pattern, job->seed, Maze_HardwareThreads());
+    timing->generateMs = (GetTime() - start) * 1000.0;
+
+    start = GetTime();
+    TexEncode_Mipmaps(&job->image);
+    if (job->compress && !TexEncode_DXT1(&job->image, Maze_HardwareThreads())) {
+        TraceLog(LOG_WARNING, "Texture compression needs square power-of-two textures; keeping %dx%d RGBA",
+                 job->width, job->height);
+    }
+    timing->encodeMs = (GetTime() - start) * 1000.0;
+
+    if (job->cacheDir) {
+        start = GetTime();
+        TexCache_Store(job->cacheDir, key, &job->image);
+        timing->cacheMs = (GetTime() - start) * 1000.0;
     }
-    
-    Texture2D texture = LoadTextureFromImage(img);
-    UnloadImage(img);  // raylib will free the memory it allocated
-    return texture;
 }
 
-// Generate procedural wooden floor texture
-Texture2D GenerateWoodFloorTexture(int width, int height) {
-    // Create image using raylib (it manages the memory)
-    Image img = GenImageColor(width, height, (Color){120, 90, 60, 255});
-    
-    // Access pixel data directly
-    Color* pixels = (Color*)img.data;
-    
-    // Create wood grain pattern
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            // Wood planks (horizontal strips)
-            int plankHeight = 64;
-            int plankIdx = y / plankHeight;
-            
-            // Add grain lines
-            float grain = sinf((float)x * 0.1f + (float)plankIdx * 0.5f) * 0.1f;
-            float variation = ((float)(rand() % 100) / 100.0f) * 0.2f;
-            
-            int r = 120 + (int)((grain + variation) * 40);
-            int g = 90 + (int)((grain + variation) * 30);
-            int b = 60 + (int)((grain + variation) * 20);
-            
-            // Plank boundaries
-            if ((y % plankHeight) < 2) {
-                r = (int)(r * 0.7f);
-                g = (int)(g * 0.7f);
-                b = (int)(b * 0.7f);
-            }
-            
-            pixels[y * width + x] = (Color){r, g, b, 255};
+// Helper: Release a prepared image without uploading it
+static void ReleaseTextureImage(TextureJob* job) {
+    if (job->entry.mapping) {
+        TexCache_Close(&job->entry);
+    } else if (job->image.data) {
+        UnloadImage(job->image);  // raylib will free the memory it allocated
+    }
+    job->image.data = NULL;
+}
+
+// Helper: GPU half of a texture (main thread), sampled trilinearly across
+// its mip chain. A GPU without S3TC gets compressed textures decoded back
+// to RGBA.
+static Texture2D UploadTexture(TextureJob* job) {
+    double start = GetTime();
+    Texture2D texture = LoadTextureFromImage(job->image);
+    if (texture.id == 0 && job->image.format == PIXELFORMAT_COMPRESSED_DXT1_RGB) {
+        TraceLog(LOG_WARNING, "DXT1 textures are not supported here; uploading decoded RGBA");
+        Image decoded = TexEncode_DecodeDXT1(&job->image);
+        if (decoded.data) {
+            texture = LoadTextureFromImage(decoded);
+            UnloadImage(decoded);
         }
     }
-    
-    Texture2D texture = LoadTextureFromImage(img);
-    UnloadImage(img);  // raylib will free the memory it allocated
+    if (texture.mipmaps > 1) SetTextureFilter(texture, TEXTURE_FILTER_TRILINEAR);
+    job->timing.uploadMs = (GetTime() - start) * 1000.0;
+    ReleaseTextureImage(job);
     return texture;
 }
 
+// Helper: Prepare and upload a texture in one go, drawing its seed from rng
+static Texture2D GenerateTexture(int width, int height, ProcTexPattern pattern, Rng* rng) {
+    TextureJob job = {.width = width, .height = height, .pattern = pattern, .seed = Rng_Next(rng)};
+    PrepareTexture(&job);
+    return UploadTexture(&job);
+}
+
+// Generate procedural stone wall texture
+Texture2D GenerateStoneWallTexture(int width, int height, Rng* rng) {
+    return GenerateTexture(width, height, PROCTEX_STONE, rng);
+}
+
+// Generate procedural wooden floor texture
+Texture2D GenerateWoodFloorTexture(int width, int height, Rng* rng) {
+    return GenerateTexture(width, height, PROCTEX_WOOD, rng);
+}
+
 // Generate simple ceiling texture
-Texture2D GenerateCeilingTexture(int width, int height) {
-    // Create image using raylib (it manages the memory)
-    Image img = GenImageColor(width, height, (Color){150, 150, 155, 255});
-    
-    // Access pixel data directly
-    Color* pixels = (Color*)img.data;
-    
-    // Add subtle noise
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            float noise = ((float)(rand() % 100) / 100.0f) * 0.15f;
-            int r = 150 + (int)(noise * 20);
-            int g = 150 + (int)(noise * 20);
-            int b = 155 + (int)(noise * 20);
-            pixels[y * width + x] = (Color){r, g, b, 255};
-        }
+Texture2D GenerateCeilingTexture(int width, int height, Rng* rng) {
+    return GenerateTexture(width, height, PROCTEX_CEILING, rng);
+}
+
+// Helper: Texture slot for an AssetTexture
+static Texture2D* AssetSlot(GameAssets* assets, int which) {
+    switch (which) {
+        case ASSET_TEXTURE_WALL: return &assets->wallTexture;
+        case ASSET_TEXTURE_FLOOR: return &assets->floorTexture;
+        default: return &assets->ceilingTexture;
     }
-    
-    Texture2D texture = LoadTextureFromImage(img);
-    UnloadImage(img);  // raylib will free the memory it allocated
-    return texture;
 }
 
-GameAssets* Assets_Load(void) {
-    GameAssets* assets = (GameAssets*)malloc(sizeof(GameAssets));
+// Helper: Loader thread body; textures are published one at a time, in
+// the order the game uploads them
+static void* LoaderWorker(void* arg) {
+    AssetLoader* loader = (AssetLoader*)arg;
+    for (int i = 0; i < ASSET_TEXTURE_COUNT; i++) {
+        if (atomic_load_explicit(&loader->cancel, memory_order_relaxed)) break;
+        PrepareTexture(&loader->jobs[i]);
+        atomic_store_explicit(&loader->jobs[i].ready, true, memory_order_release);
+    }
+    return NULL;
+}
+
+// Start loading the textures described by settings (NULL for defaults). The
+// assets come back at once holding flat placeholders in each texture's
+// base colour; a worker thread generates the real ones and Assets_Poll
+// swaps them in, so startup does not wait on texture size or count.
+GameAssets* Assets_Load(uint64_t seed, const AssetSettings* settings) {
+    GameAssets* assets = (GameAssets*)calloc(1, sizeof(GameAssets));
     if (!assets) return NULL;
+    AssetLoader* loader = (AssetLoader*)calloc(1, sizeof(AssetLoader));
+    if (!loader) {
+        free(assets);
+        return NULL;
+    }
+    const AssetSettings defaults = {0};
+    if (!settings) settings = &defaults;
+    const int textureSize = settings->textureSize > 0 ? settings->textureSize : ASSET_TEXTURE_SIZE;
     
-    assets->wallTexture = GenerateStoneWallTexture(256, 256);
-    assets->floorTexture = GenerateWoodFloorTexture(256, 256);
-    assets->ceilingTexture = GenerateCeilingTexture(256, 256);
+    // Each texture gets its own stream so they can be generated in any order
+    static const RngStream streams[ASSET_TEXTURE_COUNT] = {
+        RNG_STREAM_TEXTURE_WALL, RNG_STREAM_TEXTURE_FLOOR, RNG_STREAM_TEXTURE_CEILING
+    };
+    static const ProcTexPattern patterns[ASSET_TEXTURE_COUNT] = {PROCTEX_STONE, PROCTEX_WOOD, PROCTEX_CEILING};
+    static const Color placeholders[ASSET_TEXTURE_COUNT] = {
+        {80, 80, 85, 255}, {120, 90, 60, 255}, {150, 150, 155, 255}
+    };
+    for (int i = 0; i < ASSET_TEXTURE_COUNT; i++) {
+        TextureJob* job = &loader->jobs[i];
+        Rng rng = Rng_ForStream(seed, streams[i], 0);
+        job->width = textureSize;
+        job->height = textureSize;
+        job->pattern = patterns[i];
+        job->seed = Rng_Next(&rng);
+        job->compress = settings->compress;
+        job->cacheDir = settings->cacheDir;
+        atomic_init(&job->ready, false);
+
+        Image flat = GenImageColor(1, 1, placeholders[i]);
+        *AssetSlot(assets, i) = LoadTextureFromImage(flat);
+        UnloadImage(flat);
+    }
+    atomic_init(&loader->cancel, false);
     assets->loaded = true;
+
+    // Shader materials need no textures beyond the placeholders
+    if (settings->shaderMaterials) {
+        Rng rng = Rng_ForStream(seed, RNG_STREAM_MATERIALS, 0);
+        if (ProcMaterial_Load(&assets->material, Rng_Next(&rng))) {
+            assets->shaderMaterials = true;
+            free(loader);
+            return assets;
+        }
+        TraceLog(LOG_WARNING, "Material shader failed to compile; generating textures instead");
+    }
+
+    // Without a thread the textures are prepared one per poll instead
+    loader->threaded = pthread_create(&loader->thread, NULL, LoaderWorker, loader) == 0;
+    if (!loader->threaded) TraceLog(LOG_WARNING, "Could not start the asset loader thread");
+    assets->loader = loader;
     
     return assets;
 }
 
+// Upload the next finished texture, if any, in place of its placeholder.
+// Call once a frame on the main thread; at most one texture is uploaded
+// per call so a large one costs a single frame. Returns the AssetTexture
+// that changed (its timing is then final), or -1.
+int Assets_Poll(GameAssets* assets) {
+    if (!assets || !assets->loader) return -1;
+    AssetLoader* loader = assets->loader;
+
+    int which = loader->next;
+    TextureJob* job = &loader->jobs[which];
+    if (!atomic_load_explicit(&job->ready, memory_order_acquire)) {
+        if (loader->threaded) return -1;
+        PrepareTexture(job);
+    }
+
+    Texture2D* slot = AssetSlot(assets, which);
+    UnloadTexture(*slot);
+    *slot = UploadTexture(job);
+    assets->timings[which] = job->timing;
+
+    if (++loader->next == ASSET_TEXTURE_COUNT) {
+        if (loader->threaded) pthread_join(loader->thread, NULL);
+        free(loader);
+        assets->loader = NULL;
+    }
+    return which;
+}
+
+// Wait for every texture and swap them all in
+void Assets_Finish(GameAssets* assets) {
+    if (!assets || !assets->loader) return;
+    AssetLoader* loader = assets->loader;
+    if (loader->threaded) {
+        pthread_join(loader->thread, NULL);
+        loader->threaded = false;
+    }
+    while (assets->loader) Assets_Poll(assets);
+}
+
 void Assets_Unload(GameAssets* assets) {
     if (!assets || !assets->loaded) return;
     
+    // Stop the loader and drop whatever it finished but was never uploaded
+    AssetLoader* loader = assets->loader;
+    if (loader) {
+        atomic_store_explicit(&loader->cancel, true, memory_order_relaxed);
+        if (loader->threaded) pthread_join(loader->thread, NULL);
+        for (int i = loader->next; i < ASSET_TEXTURE_COUNT; i++) {
+            if (atomic_load_explicit(&loader->jobs[i].ready, memory_order_acquire)) {
+                ReleaseTextureImage(&loader->jobs[i]);
+            }
+        }
+        free(loader);
+        assets->loader = NULL;
+    }
+    
+    ProcMaterial_Unload(&assets->material);
     UnloadTexture(assets->wallTexture);
     UnloadTexture(assets->floorTexture);
     UnloadTexture(assets->ceilingTexture);
@@ -120,102 +277,61 @@ void Assets_Unload(GameAssets* assets) {
     free(assets);
 }
 
-int Torches_Generate(const Maze* maze, Torch** outTorches, int maxTorches) {
-    if (!maze || !outTorches || maxTorches <= 0) return 0;
-    
-    *outTorches = (Torch*)malloc(maxTorches * sizeof(Torch));
-    if (!*outTorches) return 0;
+// Helper: Number of wall cells to skip before the next torch (geometric
+// distribution), so placement costs one draw per torch instead of one per wall
+static int NextTorchGap(Rng* rng, float chance) {
+    float u = 1.0f - Rng_Float(rng);
+    return (int)(logf(u) / logf(1.0f - chance));
+}
+
+// Place up to maxTorches torches into outTorches; returns how many
+int Torches_Generate(const Maze* maze, const WallRect* walls, int wallCount, Torch* outTorches, int maxTorches, Rng* rng) {
+    if (!maze || !walls || !outTorches || maxTorches <= 0 || !rng) return 0;
     
     int count = 0;
     const float torchHeight = 2.0f;
     const float wallOffset = 0.11f;
     const float torchPlacementChance = 0.08f;
+    const float originX = -maze->width * 0.5f * maze->cellSize;
+    const float originZ = -maze->height * 0.5f * maze->cellSize;
     
-    // collect all wall positions first
-    typedef struct {
-        int x, y;
-        int direction; // 0=N, 1=S, 2=W, 3=E
-        float worldX, worldZ;
-    } WallPos;
-    
-    WallPos* walls = (WallPos*)malloc(maze->width * maze->height * 4 * sizeof(WallPos));
-    int wallCount = 0;
-    
-    // Collect all walls
-    for (int y = 0; y < maze->height; y++) {
-        for (int x = 0; x < maze->width; x++) {
-            float worldX = (x - maze->width * 0.5f + 0.5f) * maze->cellSize;
-            float worldZ = (y - maze->height * 0.5f + 0.5f) * maze->cellSize;
-            float halfCell = maze->cellSize * 0.5f;
-            
-            if (Maze_HasWall(maze, x, y, MAZE_NORTH)) {
-                walls[wallCount++] = (WallPos){x, y, 0, worldX, worldZ - halfCell};
-            }
-            if (Maze_HasWall(maze, x, y, MAZE_SOUTH)) {
-                walls[wallCount++] = (WallPos){x, y, 1, worldX, worldZ + halfCell};
-            }
-            if (Maze_HasWall(maze, x, y, MAZE_WEST)) {
-                walls[wallCount++] = (WallPos){x, y, 2, worldX - halfCell, worldZ};
-            }
-            if (Maze_HasWall(maze, x, y, MAZE_EAST)) {
-                walls[wallCount++] = (WallPos){x, y, 3, worldX + halfCell, worldZ};
-            }
-        }
-    }
-    
-    // Randomly place torches on a small percentage of walls
+    // Walk both faces of every merged wall run as one long strip of wall
+    // cells, jumping straight to the cells that get a torch
+    int gap = NextTorchGap(rng, torchPlacementChance);
     for (int i = 0; i < wallCount && count < maxTorches; i++) {
-        // Random chance to place a torch on this wall
-        if ((float)rand() / (float)RAND_MAX < torchPlacementChance) {
-            WallPos* wall = &walls[i];
-            float halfCell = maze->cellSize * 0.5f;
-            
-            // Random position along the wall
-            float randomOffset = ((float)rand() / (float)RAND_MAX) * (maze->cellSize - 0.5f) + 0.25f;
+        const WallRect* wall = &walls[i];
+        float lineX = originX + wall->x * maze->cellSize;
+        float lineZ = originZ + wall->y * maze->cellSize;
+        
+        for (int side = -1; side <= 1 && count < maxTorches; side += 2) {
+            // Skip faces on the outside of the border
+            int lattice = wall->isVertical ? wall->x : wall->y;
+            int limit = wall->isVertical ? maze->width : maze->height;
+            if ((side < 0 && lattice == 0) || (side > 0 && lattice == limit)) continue;
             
-            switch (wall->direction) {
-                case 0: // North
-                    (*outTorches)[count].position = (Vector3){
-                        wall->worldX - halfCell + randomOffset,
-                        torchHeight,
-                        wall->worldZ - wallOffset
-                    };
-                    (*outTorches)[count].normal = (Vector3){0, 0, 1};
-                    break;
-                case 1: // South
-                    (*outTorches)[count].position = (Vector3){
-                        wall->worldX - halfCell + randomOffset,
-                        torchHeight,
-                        wall->worldZ + wallOffset
-                    };
-                    (*outTorches)[count].normal = (Vector3){0, 0, -1};
-                    break;
-                case 2: // West
-                    (*outTorches)[count].position = (Vector3){
-                        wall->worldX - wallOffset,
-                        torchHeight,
-                        wall->worldZ - halfCell + randomOffset
-                    };
-                    (*outTorches)[count].normal = (Vector3){1, 0, 0};
-                    break;
-                case 3: // East
-                    (*outTorches)[count].position = (Vector3){
-                        wall->worldX + wallOffset,
-                        torchHeight,
-                        wall->worldZ - halfCell + randomOffset
-                    };
-                    (*outTorches)[count].normal = (Vector3){-1, 0, 0};
-                    break;
+            while (gap < wall->length && count < maxTorches) {
+                // Random position along the wall cell
+                float along = gap * maze->cellSize +
+                              Rng_Float(rng) * (maze->cellSize - 0.5f) + 0.25f;
+                Torch* torch = &outTorches[count];
+                
+                if (wall->isVertical) {
+                    torch->position = (Vector3){lineX + side * wallOffset, torchHeight, lineZ + along};
+                    torch->normal = (Vector3){(float)side, 0, 0};
+                } else {
+                    torch->position = (Vector3){lineX + along, torchHeight, lineZ + side * wallOffset};
+                    torch->normal = (Vector3){0, 0, (float)side};
+                }
+                torch->flickerTime = (float)Rng_Range(rng, 1000) / 1000.0f * 6.28f;
+                torch->baseIntensity = 0.6f + ((float)Rng_Range(rng, 30) / 100.0f);
+                count++;
+                
+                gap += 1 + NextTorchGap(rng, torchPlacementChance);
             }
-            
-            (*outTorches)[count].flickerTime = (float)(rand() % 1000) / 1000.0f * 6.28f;
-            (*outTorches)[count].baseIntensity = 0.6f + ((float)(rand() % 30) / 100.0f);
-            
-            count++;
+            gap -= wall->length;
         }
     }
     
-    free(walls);
     return count;
 }
 
@@ -243,31 +359,17 @@ void Torches_Render(const Torch* torches, int count) {
     }
 }
 
-// Create particle system
-ParticleSystem* ParticleSystem_Create(int maxParticles) {
-    ParticleSystem* ps = (ParticleSystem*)malloc(sizeof(ParticleSystem));
-    if (!ps) return NULL;
-    
-    ps->particles = (Particle*)malloc(maxParticles * sizeof(Particle));
-    if (!ps->particles) {
-        free(ps);
-        return NULL;
-    }
-    
-    ps->maxParticles = maxParticles;
+// Set up a particle system over caller-owned storage for maxParticles
+// particles (a system without storage emits nothing)
+void ParticleSystem_Init(ParticleSystem* ps, Particle* particles, int maxParticles, Rng rng) {
+    if (!ps) return;
+    ps->particles = particles;
+    ps->maxParticles = particles ? maxParticles : 0;
     ps->activeParticles = 0;
     ps->emitRate = 15.0f;
     ps->emitAccumulator = 0.0f;
     ps->emitterPos = (Vector3){0, 0, 0};
-    
-    return ps;
-}
-
-// Destroy particle system
-void ParticleSystem_Destroy(ParticleSystem* ps) {
-    if (!ps) return;
-    if (ps->particles) free(ps->particles);
-    free(ps);
+    ps->rng = rng;
 }
 
 // Update particle system
@@ -286,16 +388,16 @@ void ParticleSystem_Update(ParticleSystem* ps, Vector3 emitterPos, float dt) {
         p->position = emitterPos;
         p->position.y += 0.25f; // Slight offset above torch
         p->velocity = (Vector3){
-            ((float)(rand() % 200) - 100.0f) / 500.0f,
-            ((float)(rand() % 300) + 100.0f) / 500.0f,
-            ((float)(rand() % 200) - 100.0f) / 500.0f
+            ((float)Rng_Range(&ps->rng, 200) - 100.0f) / 500.0f,
+            ((float)Rng_Range(&ps->rng, 300) + 100.0f) / 500.0f,
+            ((float)Rng_Range(&ps->rng, 200) - 100.0f) / 500.0f
         };
         p->life = 1.0f;
-        p->maxLife = 0.5f + ((float)(rand() % 50) / 100.0f);
-        p->size = 0.05f + ((float)(rand() % 30) / 1000.0f);
+        p->maxLife = 0.5f + ((float)Rng_Range(&ps->rng, 50) / 100.0f);
+        p->size = 0.05f + ((float)Rng_Range(&ps->rng, 30) / 1000.0f);
         p->color = (Color){
             255,
-            150 + (rand() % 50),
+            150 + Rng_Range(&ps->rng, 50),
             0,
             255
         };
@@ -0,0 +1,282 @@
+#include "../include/chunkedmaze.h"
+#include <stdlib.h>
+#include <string.h>
+
+// One cached chunk
+typedef struct {
+    int cx, cy;             // Chunk coordinates
+    int w, h;               // Size in cells (edge chunks may be smaller)
+    uint64_t lastUse;
+    int next;               // Next slot in the same hash bucket (-1 ends)
+    unsigned char* cells;   // w * h wall flags
+} ChunkSlot;
+
+// Chunked maze backend: a perfect maze per chunk, generated on demand from
+// (seed, chunkX, chunkY), stitched by a spanning tree over the chunks
+typedef struct {
+    uint64_t seed;
+    MazeAlgorithm algorithm;
+    int width, height;
+    int chunksX, chunksY;
+    ChunkSlot* slots;
+    int used;
+    int* buckets;           // Hash of (cx, cy) -> first slot
+    unsigned char* store;   // Cell memory for every slot
+    int capacity;           // Slots (CHUNKED_MAZE_CACHE unless raised for a full pass)
+    int bucketCount;
+    uint64_t tick;
+    int lastSlot;           // Most recent hit, checked first
+    void* scratch;          // Generator scratch for one full chunk, so misses never allocate
+    size_t scratchSize;
+    ChunkCacheStats stats;
+} ChunkCache;
+
+// Helper: Bucket of a chunk coordinate
+static int ChunkBucket(const ChunkCache* cache, int cx, int cy) {
+    uint32_t h = (uint32_t)cx * 0x9E3779B1u ^ (uint32_t)cy * 0x85EBCA77u;
+    return (int)((h ^ (h >> 16)) % (uint32_t)cache->bucketCount);
+}
+
+// Helper: Door from a chunk into the spanning tree over chunks. Chunk (0, 0)
+// is the root; the top row links west, the left column north, and every
+// other chunk flips a seeded coin (a binary-tree maze at chunk scale). The
+// door sits at a seeded offset along the shared border.
+static int ChunkLink(const ChunkCache* cache, int cx, int cy, int* outOffset) {
+    if (cx == 0 && cy == 0) return 0;
+
+    uint64_t h = Rng_Mix(Rng_Mix(cache->seed, (uint64_t)(uint32_t)cx), (uint64_t)(uint32_t)cy);
+    int dir;
+    if (cy == 0) dir = MAZE_WEST;
+    else if (cx == 0) dir = MAZE_NORTH;
+    else dir = (h & 1) ? MAZE_NORTH : MAZE_WEST;
+
+    // Extent of the border the door lies on
+    int extent;
+    if (dir == MAZE_NORTH) {
+        extent = cache->width - cx * CHUNKED_MAZE_CHUNK;
+    } else {
+        extent = cache->height - cy * CHUNKED_MAZE_CHUNK;
+    }
+    if (extent > CHUNKED_MAZE_CHUNK) extent = CHUNKED_MAZE_CHUNK;
+    *outOffset = (int)((h >> 8) % (uint64_t)extent);
+    return dir;
+}
+
+// Helper: Build one chunk: its own perfect maze, then the doors to the
+// neighbours it is linked with in the chunk tree
+static void GenerateChunk(ChunkCache* cache, ChunkSlot* slot) {
+    int w = slot->w;
+    int h = slot->h;
+
+    Maze local = {0};
+    local.width = w;
+    local.height = h;
+    local.cells = slot->cells;
+    local.cellSize = 1.0f;
+    Rng rng = Rng_ForStream(cache->seed, RNG_STREAM_MAZE,
+                            ((uint64_t)(uint32_t)slot->cy << 32) | (uint32_t)slot->cx);
+    Maze_GenerateInto(&local, cache->algorithm, &rng, cache->scratch, cache->scratchSize);
+
+    int offset;
+    int dir = ChunkLink(cache, slot->cx, slot->cy, &offset);
+    if (dir == MAZE_NORTH) slot->cells[offset] &= (unsigned char)~MAZE_NORTH;
+    if (dir == MAZE_WEST) slot->cells[offset * w] &= (unsigned char)~MAZE_WEST;
+
+    // Doors opened by the south and east neighbours towards this chunk
+    if (slot->cy + 1 < cache->chunksY && ChunkLink(cache, slot->cx, slot->cy + 1, &offset) == MAZE_NORTH) {
+        slot->cells[(h - 1) * w + offset] &= (unsigned char)~MAZE_SOUTH;
+    }
+    if (slot->cx + 1 < cache->chunksX && ChunkLink(cache, slot->cx + 1, slot->cy, &offset) == MAZE_WEST) {
+        slot->cells[offset * w + w - 1] &= (unsigned char)~MAZE_EAST;
+    }
+}
+
+// Helper: Find a chunk in the cache, generating it (and evicting the least
+// recently used chunk) on a miss
+static ChunkSlot* AcquireChunk(ChunkCache* cache, int cx, int cy) {
+    cache->tick++;
+    cache->stats.lookups++;
+
+    ChunkSlot* last = &cache->slots[cache->lastSlot];
+    if (cache->used > 0 && last->cx == cx && last->cy == cy) {
+        last->lastUse = cache->tick;
+        return last;
+    }
+
+    int bucket = ChunkBucket(cache, cx, cy);
+    for (int i = cache->buckets[bucket]; i >= 0; i = cache->slots[i].next) {
+        if (cache->slots[i].cx == cx && cache->slots[i].cy == cy) {
+            cache->slots[i].lastUse = cache->tick;
+            cache->lastSlot = i;
+            return &cache->slots[i];
+        }
+    }
+
+    // Miss: take a free slot or evict the least recently used one
+    int index;
+    if (cache->used < cache->capacity) {
+        index = cache->used++;
+    } else {
+        index = 0;
+        for (int i = 1; i < cache->capacity; i++) {
+            if (cache->slots[i].lastUse < cache->slots[index].lastUse) index = i;
+        }
+
+        int* link = &cache->buckets[ChunkBucket(cache, cache->slots[index].cx, cache->slots[index].cy)];
+        while (*link != index) link = &cache->slots[*link].next;
+        *link = cache->slots[index].next;
+        cache->stats.evictions++;
+    }
+
+    ChunkSlot* slot = &cache->slots[index];
+    slot->cx = cx;
+    slot->cy = cy;
+    slot->w = cache->width - cx * CHUNKED_MAZE_CHUNK;
+    slot->h = cache->height - cy * CHUNKED_MAZE_CHUNK;
+    if (slot->w > CHUNKED_MAZE_CHUNK) slot->w = CHUNKED_MAZE_CHUNK;
+    if (slot->h > CHUNKED_MAZE_CHUNK) slot->h = CHUNKED_MAZE_CHUNK;
+    slot->lastUse = cache->tick;
+    slot->next = cache->buckets[bucket];
+    cache->buckets[bucket] = index;
+    cache->lastSlot = index;
+
+    GenerateChunk(cache, slot);
+    cache->stats.generated++;
+    cache->stats.resident = cache->used;
+    return slot;
+}
+
+// Helper: MazeSource callback
+static unsigned char ChunkedGetCell(void* user, int x, int y) {
+    ChunkCache* cache = (ChunkCache*)user;
+    ChunkSlot* slot = AcquireChunk(cache, x / CHUNKED_MAZE_CHUNK, y / CHUNKED_MAZE_CHUNK);
+    return slot->cells[(y % CHUNKED_MAZE_CHUNK) * slot->w + x % CHUNKED_MAZE_CHUNK];
+}
+
+// Helper: MazeSource callback
+static void ChunkedDestroy(void* user) {
+    ChunkCache* cache = (ChunkCache*)user;
+    if (!cache) return;
+    free(cache->slots);
+    free(cache->buckets);
+    free(cache->store);
+    free(cache->scratch);
+    free(cache);
+}
+
+// Helper: (Re)allocate the cache for `capacity` chunks. Resident chunks are
+// dropped; they regenerate identically on their next use.
+static bool AllocateCache(ChunkCache* cache, int capacity) {
+    const size_t chunkBytes = (size_t)CHUNKED_MAZE_CHUNK * CHUNKED_MAZE_CHUNK;
+    ChunkSlot* slots = (ChunkSlot*)calloc((size_t)capacity, sizeof(ChunkSlot));
+    int* buckets = (int*)malloc((size_t)capacity * 2 * sizeof(int));
+    unsigned char* store = (unsigned char*)malloc((size_t)capacity * chunkBytes);
+    if (!slots || !buckets || !store) {
+        free(slots);
+        free(buckets);
+        free(store);
+        return false;
+    }
+
+    free(cache->slots);
+    free(cache->buckets);
+    free(cache->store);
+    cache->slots = slots;
+    cache->buckets = buckets;
+    cache->store = store;
+    cache->capacity = capacity;
+    cache->bucketCount = capacity * 2;
+    cache->used = 0;
+    cache->lastSlot = 0;
+    for (int i = 0; i < cache->bucketCount; i++) cache->buckets[i] = -1;
+    for (int i = 0; i < capacity; i++) {
+        cache->slots[i].cells = &cache->store[(size_t)i * chunkBytes];
+        cache->slots[i].next = -1;
+    }
+    cache->stats.resident = 0;
+    return true;
+}
+
+// Create a very large maze whose chunks are generated on first use and kept
+// in a bounded LRU cache of CHUNKED_MAZE_CACHE chunks; any chunk can be
+// rebuilt identically from the seed. Passes over the whole maze should
+// raise the cache to ChunkedMaze_ChunkCount first (ChunkedMaze_SetCacheChunks).
+Maze* ChunkedMaze_Create(int width, int height, float cellSize, uint64_t seed, MazeAlgorithm algorithm) {
+    if (width < 1 || height < 1) return NULL;
+
+    ChunkCache* cache = (ChunkCache*)calloc(1, sizeof(ChunkCache));
+    if (!cache) return NULL;
+
+    cache->seed = seed;
+    cache->algorithm = algorithm;
+    cache->width = width;
+    cache->height = height;
+    cache->chunksX = (width + CHUNKED_MAZE_CHUNK - 1) / CHUNKED_MAZE_CHUNK;
+    cache->chunksY = (height + CHUNKED_MAZE_CHUNK - 1) / CHUNKED_MAZE_CHUNK;
+    cache->scratchSize = Maze_GenerateScratchSize(CHUNKED_MAZE_CHUNK, CHUNKED_MAZE_CHUNK, MAZE_STORAGE_BYTES,
+                                                  algorithm);
+    cache->scratch = malloc(cache->scratchSize > 0 ? cache->scratchSize : 1);
+    if (!cache->scratch || !AllocateCache(cache, CHUNKED_MAZE_CACHE)) {
+        ChunkedDestroy(cache);
+        return NULL;
+    }
+
+    MazeSource source = {ChunkedGetCell, ChunkedDestroy, cache, NULL};
+    Maze* maze = Maze_CreateWithSource(width, height, cellSize, source);
+    if (maze) maze->seed = seed;
+    else ChunkedDestroy(cache);
+    return maze;
+}
+
+// Check whether a maze is backed by the chunk cache
+bool ChunkedMaze_Is(const Maze* maze) {
+    return maze && !maze->cells && maze->source.getCell == ChunkedGetCell;
+}
+
+// Make sure the chunks around a cell are resident, e.g. around the player
+// each frame, so crossing into them never stalls on generation
+void ChunkedMaze_Prefetch(const Maze* maze, int cellX, int cellY, int radiusChunks) {
+    if (!ChunkedMaze_Is(maze)) return;
+    ChunkCache* cache = (ChunkCache*)maze->source.user;
+
+    // Never ask for more chunks than the cache holds, or it would thrash
+    while (radiusChunks > 0 && (2 * radiusChunks + 1) * (2 * radiusChunks + 1) > cache->capacity / 2) {
+        radiusChunks--;
+    }
+
+    int centerX = cellX / CHUNKED_MAZE_CHUNK;
+    int centerY = cellY / CHUNKED_MAZE_CHUNK;
+    for (int cy = centerY - radiusChunks; cy <= centerY + radiusChunks; cy++) {
+        for (int cx = centerX - radiusChunks; cx <= centerX + radiusChunks; cx++) {
+            if (cx < 0 || cy < 0 || cx >= cache->chunksX || cy >= cache->chunksY) continue;
+            AcquireChunk(cache, cx, cy);
+        }
+    }
+}
+
+// Number of chunks in the maze (0 for other mazes)
+int ChunkedMaze_ChunkCount(const Maze* maze) {
+    if (!ChunkedMaze_Is(maze)) return 0;
+    const ChunkCache* cache = (const ChunkCache*)maze->source.user;
+    return cache->chunksX * cache->chunksY;
+}
+
+// Resize the cache. A pass that reads every cell (wall runs, flow field,
+// PVS) would regenerate each chunk once per lattice line with the default
+// cache, so it raises the cache to every chunk for the pass and lowers it
+// after. Resident chunks are dropped. False (cache unchanged) if the memory
+// is not there; does nothing for other mazes.
+bool ChunkedMaze_SetCacheChunks(Maze* maze, int chunks) {
+    if (!ChunkedMaze_Is(maze)) return true;
+    ChunkCache* cache = (ChunkCache*)maze->source.user;
+    if (chunks < 1) chunks = 1;
+    if (chunks == cache->capacity) return true;
+    return AllocateCache(cache, chunks);
+}
+
+// Cache counters (all zero for other mazes)
+ChunkCacheStats ChunkedMaze_GetStats(const Maze* maze) {
+    ChunkCacheStats stats = {0};
+    if (ChunkedMaze_Is(maze)) stats = ((const ChunkCache*)maze->source.user)->stats;
+    return stats;
+}
@@ -0,0 +1,527 @@
+#include "../include/compressedmaze.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Container layout: ContainerHeader, then blockCount + 1 little-endian
+// uint64 offsets into the block data (block i spans offsets[i]..[i + 1]),
+// then the blocks. Blocks are COMPRESSED_MAZE_BLOCK cells square in raster
+// order and each is coded on its own, so any cell needs one block decoded.
+#define CONTAINER_MAGIC   "MAZC"
+#define CONTAINER_VERSION 1
+
+// Each cell stores its MAZE_PACKED_NORTH and MAZE_PACKED_WEST edge, coded
+// with an adaptive binary range coder (LZMA style: 11-bit probabilities,
+// shift-6 adaptation). Every block starts from probabilities trained over
+// the whole maze and stored in the header. The contexts are the
+// already-coded edges around the cell's north-west corner and the cell
+// above, which captures the two rules of a perfect maze: no corner is free
+// of walls, and no cell is walled on all four sides.
+#define PROB_BITS      11
+#define PROB_ONE       (1u << PROB_BITS)
+#define PROB_ADAPT     6
+#define RANGE_TOP      (1u << 24)
+#define CONTEXT_COUNT  32
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t width, height;
+    float cellSize;
+    float startX, startY;
+    float exitX, exitY;
+    uint32_t blockSize;
+    uint64_t seed;
+    uint64_t blockCount;
+    uint16_t priors[CONTEXT_COUNT]; // Starting probability of each context
+} ContainerHeader;
+
+// Growable output buffer
+typedef struct {
+    unsigned char* data;
+    size_t size;
+    size_t capacity;
+    bool failed;
+} ByteBuffer;
+
+typedef struct {
+    ByteBuffer* out;
+    uint64_t low;
+    uint32_t range;
+    unsigned char cache;
+    uint64_t cacheSize;
+} RangeEncoder;
+
+typedef struct {
+    const unsigned char* data;
+    size_t size;
+    size_t pos;
+    uint32_t code;
+    uint32_t range;
+} RangeDecoder;
+
+// One decoded block
+typedef struct {
+    int bx, by;                 // Block coordinates (-1 while unused)
+    int w, h;                   // Size in cells (edge blocks may be smaller)
+    uint64_t lastUse;
+    unsigned char* bits;        // w * h MAZE_PACKED_* pairs, one per byte
+} BlockSlot;
+
+// Compressed backend: the whole container in memory, blocks decoded on
+// demand into a small LRU cache
+typedef struct {
+    int width, height;
+    int blocksX, blocksY;
+    unsigned char* file;        // Container as read from disk
+    size_t fileSize;
+    const unsigned char* blocks;
+    size_t blocksSize;
+    const unsigned char* index; // blockCount + 1 offsets
+    BlockSlot* slots;
+    int slotCount;
+    int* blockSlot;             // Slot holding each block (-1 if not decoded)
+    uint16_t priors[CONTEXT_COUNT];
+    unsigned char* store;       // Bits for every slot
+    uint64_t tick;
+    CompressedMazeStats stats;
+} BlockCache;
+
+// Helper: Append a byte, growing the buffer
+static void PutByte(ByteBuffer* buffer, unsigned char byte) {
+    if (buffer->failed) return;
+    if (buffer->size == buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity * 2 : 4096;
+        unsigned char* data = (unsigned char*)realloc(buffer->data, capacity);
+        if (!data) {
+            buffer->failed = true;
+            return;
+        }
+        buffer->data = data;
+        buffer->capacity = capacity;
+    }
+    buffer->data[buffer->size++] = byte;
+}
+
+// Helper: Push the settled top byte of low to the output (carry aware)
+static void ShiftLow(RangeEncoder* rc) {
+    if ((uint32_t)rc->low < 0xFF000000u || (rc->low >> 32) != 0) {
+        unsigned char carry = (unsigned char)(rc->low >> 32);
+        unsigned char temp = rc->cache;
+        do {
+            PutByte(rc->out, (unsigned char)(temp + carry));
+            temp = 0xFF;
+        } while (--rc->cacheSize != 0);
+        rc->cache = (unsigned char)((uint32_t)rc->low >> 24);
+    }
+    rc->cacheSize++;
+    rc->low = (uint32_t)rc->low << 8;
+}
+
+// Helper: Code one bit with an adaptive probability (of a 0)
+static void EncodeBit(RangeEncoder* rc, uint16_t* prob, unsigned int bit) {
+    uint32_t bound = (rc->range >> PROB_BITS) * *prob;
+    if (!bit) {
+        rc->range = bound;
+        *prob += (uint16_t)((PROB_ONE - *prob) >> PROB_ADAPT);
+    } else {
+        rc->low += bound;
+        rc->range -= bound;
+        *prob -= (uint16_t)(*prob >> PROB_ADAPT);
+    }
+    while (rc->range < RANGE_TOP) {
+        rc->range <<= 8;
+        ShiftLow(rc);
+    }
+}
+
+// Helper: Next input byte (zeros past the end, so corrupt blocks stay bounded)
+static unsigned char GetByte(RangeDecoder* rd) {
+    return rd->pos < rd->size ? rd->data[rd->pos++] : 0;
+}
+
+// Helper: Decode one bit, mirroring EncodeBit. Maze edges are close to
+// coin flips, so the update is done with masks rather than a branch that
+// would mispredict about half the time.
+static unsigned int DecodeBit(RangeDecoder* rd, uint16_t* prob) {
+    uint32_t p = *prob;
+    uint32_t bound = (rd->range >> PROB_BITS) * p;
+    unsigned int bit = rd->code >= bound;
+    uint32_t mask = 0u - bit;
+    rd->code -= bound & mask;
+    rd->range = (bound & ~mask) | ((rd->range - bound) & mask);
+    *prob = (uint16_t)(((p + ((PROB_ONE - p) >> PROB_ADAPT)) & ~mask) | ((p - (p >> PROB_ADAPT)) & mask));
+    while (rd->range < RANGE_TOP) {
+        rd->range <<= 8;
+        rd->code = (rd->code << 8) | GetByte(rd);
+    }
+    return bit;
+}
+
+// Coding works on a copy of the block framed by walls (one row above, one
+// column either side), so the contexts never need a bounds check
+#define GRID_STRIDE (COMPRESSED_MAZE_BLOCK + 2)
+#define GRID_SIZE   (GRID_STRIDE * (COMPRESSED_MAZE_BLOCK + 1))
+#define GRID_WALLS  (MAZE_PACKED_NORTH | MAZE_PACKED_WEST)
+
+// Helper: Frame a w x h block with walls; cell (x, y) lands at
+// grid[(y + 1) * GRID_STRIDE + x + 1]
+static void FrameGrid(unsigned char* grid, const unsigned char* bits, int w, int h) {
+    memset(grid, GRID_WALLS, GRID_STRIDE);
+    for (int y = 0; y < h; y++) {
+        unsigned char* row = &grid[(y + 1) * GRID_STRIDE];
+        row[0] = GRID_WALLS;
+        if (bits) memcpy(row + 1, &bits[y * w], (size_t)w);
+        row[w + 1] = GRID_WALLS;
+    }
+}
+
+// Helper: Context of a cell's north edge (0-15): the west cell's north edge,
+// and the walls of the cell above
+static int NorthContext(const unsigned char* row, const unsigned char* up, int x) {
+    return (int)((row[x - 1] & MAZE_PACKED_NORTH) | (up[x] & MAZE_PACKED_WEST) |
+                 (up[x] & MAZE_PACKED_NORTH) << 2 | (up[x + 1] & MAZE_PACKED_WEST) << 2);
+}
+
+// Helper: Context of a cell's west edge (16-31), given its north edge
+static int WestContext(const unsigned char* row, const unsigned char* up, int x, unsigned int north) {
+    return 16 + (int)(north | (row[x - 1] & MAZE_PACKED_NORTH) << 1 | (up[x] & MAZE_PACKED_WEST) << 1 |
+                      (row[x - 1] & MAZE_PACKED_WEST) << 2);
+}
+
+// Helper: Count the zeros and ones seen in each context of a block
+static void CountContexts(const unsigned char* bits, int w, int h, uint64_t counts[CONTEXT_COUNT][2]) {
+    unsigned char grid[GRID_SIZE];
+    FrameGrid(grid, bits, w, h);
+    for (int y = 0; y < h; y++) {
+        const unsigned char* up = &grid[y * GRID_STRIDE + 1];
+        const unsigned char* row = up + GRID_STRIDE;
+        for (int x = 0; x < w; x++) {
+            unsigned int north = row[x] & MAZE_PACKED_NORTH;
+            counts[NorthContext(row, up, x)][north]++;
+            counts[WestContext(row, up, x, north)][(row[x] & MAZE_PACKED_WEST) != 0]++;
+        }
+    }
+}
+
+// Helper: Code one block of edge pairs
+static void EncodeBlock(ByteBuffer* out, const unsigned char* bits, int w, int h, const uint16_t* priors) {
+    uint16_t probs[CONTEXT_COUNT];
+    memcpy(probs, priors, sizeof(probs));
+    unsigned char grid[GRID_SIZE];
+    FrameGrid(grid, bits, w, h);
+
+    RangeEncoder rc = {out, 0, 0xFFFFFFFFu, 0, 1};
+    for (int y = 0; y < h; y++) {
+        const unsigned char* up = &grid[y * GRID_STRIDE + 1];
+        const unsigned char* row = up + GRID_STRIDE;
+        for (int x = 0; x < w; x++) {
+            unsigned int north = row[x] & MAZE_PACKED_NORTH;
+            EncodeBit(&rc, &probs[NorthContext(row, up, x)], north);
+            EncodeBit(&rc, &probs[WestContext(row, up, x, north)], (row[x] & MAZE_PACKED_WEST) != 0);
+        }
+    }
+    for (int i = 0; i < 5; i++) ShiftLow(&rc);
+}
+
+// Helper: Decode one block of edge pairs, mirroring EncodeBlock
+static void DecodeBlock(const unsigned char* data, size_t size, unsigned char* bits, int w, int h,
+                        const uint16_t* priors) {
+    uint16_t probs[CONTEXT_COUNT];
+    memcpy(probs, priors, sizeof(probs));
+    unsigned char grid[GRID_SIZE];
+    FrameGrid(grid, NULL, w, h);
+
+    RangeDecoder rd = {data, size, 0, 0, 0xFFFFFFFFu};
+    for (int i = 0; i < 5; i++) rd.code = (rd.code << 8) | GetByte(&rd);
+    for (int y = 0; y < h; y++) {
+        const unsigned char* up = &grid[y * GRID_STRIDE + 1];
+        unsigned char* row = &grid[(y + 1) * GRID_STRIDE + 1];
+        for (int x = 0; x < w; x++) {
+            unsigned int north = DecodeBit(&rd, &probs[NorthContext(row, up, x)]);
+            unsigned int west = DecodeBit(&rd, &probs[WestContext(row, up, x, north)]);
+            row[x] = (unsigned char)(north | west << 1);
+        }
+        memcpy(&bits[y * w], row, (size_t)w);
+    }
+}
+
+// Helper: Little-endian uint64 from the block index
+static uint64_t IndexEntry(const unsigned char* index, uint64_t i) {
+    uint64_t value = 0;
+    for (int k = 7; k >= 0; k--) value = (value << 8) | index[i * 8 + (uint64_t)k];
+    return value;
+}
+
+// Write a maze (any backend) as a compressed block container
+bool CompressedMaze_Save(const Maze* maze, const char* path) {
+    if (!maze || !path) return false;
+
+    const int blocksX = (maze->width + COMPRESSED_MAZE_BLOCK - 1) / COMPRESSED_MAZE_BLOCK;
+    const int blocksY = (maze->height + COMPRESSED_MAZE_BLOCK - 1) / COMPRESSED_MAZE_BLOCK;
+    const uint64_t blockCount = (uint64_t)blocksX * blocksY;
+
+    uint64_t* offsets = (uint64_t*)malloc((size_t)(blockCount + 1) * sizeof(uint64_t));
+    unsigned char* bits = (unsigned char*)malloc(COMPRESSED_MAZE_BLOCK * COMPRESSED_MAZE_BLOCK);
+    ByteBuffer data = {0};
+    bool ok = offsets && bits;
+
+    // Pass 1 trains the starting probabilities shared by every block,
+    // pass 2 codes the blocks
+    uint64_t counts[CONTEXT_COUNT][2] = {{0}};
+    uint16_t priors[CONTEXT_COUNT];
+    for (int pass = 0; pass < 2 && ok; pass++) {
+        for (uint64_t b = 0; ok && b < blockCount; b++) {
+            int x0 = (int)(b % (uint64_t)blocksX) * COMPRESSED_MAZE_BLOCK;
+            int y0 = (int)(b / (uint64_t)blocksX) * COMPRESSED_MAZE_BLOCK;
+            int w = maze->width - x0 < COMPRESSED_MAZE_BLOCK ? maze->width - x0 : COMPRESSED_MAZE_BLOCK;
+            int h = maze->height - y0 < COMPRESSED_MAZE_BLOCK ? maze->height - y0 : COMPRESSED_MAZE_BLOCK;
+            for (int y = 0; y < h; y++) {
+                for (int x = 0; x < w; x++) {
+                    unsigned char cell = Maze_GetCell(maze, x0 + x, y0 + y);
+                    bits[y * w + x] = (unsigned char)(((cell & MAZE_NORTH) ? MAZE_PACKED_NORTH : 0) |
+                                                      ((cell & MAZE_WEST) ? MAZE_PACKED_WEST : 0));
+                }
+            }
+            if (pass == 0) {
+                CountContexts(bits, w, h, counts);
+            } else {
+                offsets[b] = data.size;
+                EncodeBlock(&data, bits, w, h, priors);
+                ok = !data.failed;
+            }
+        }
+
+        // Probability of a 0 per context, kept away from certainty
+        for (int i = 0; pass == 0 && i < CONTEXT_COUNT; i++) {
+            uint64_t p = (counts[i][0] * 2 + 1) * PROB_ONE / ((counts[i][0] + counts[i][1]) * 2 + 2);
+            priors[i] = (uint16_t)(p < 31 ? 31 : p > PROB_ONE - 31 ? PROB_ONE - 31 : p);
+        }
+    }
+
+    FILE* file = ok ? fopen(path, "wb") : NULL;
+    if (file) {
+        offsets[blockCount] = data.size;
+        ContainerHeader header = {0};
+        memcpy(header.magic, CONTAINER_MAGIC, 4);
+        header.version = CONTAINER_VERSION;
+        header.width = (uint32_t)maze->width;
+        header.height = (uint32_t)maze->height;
+        header.cellSize = maze->cellSize;
+        header.startX = maze->startPos.x;
+        header.startY = maze->startPos.y;
+        header.exitX = maze->exitPos.x;
+        header.exitY = maze->exitPos.y;
+        header.blockSize = COMPRESSED_MAZE_BLOCK;
+        header.seed = maze->seed;
+        header.blockCount = blockCount;
+        memcpy(header.priors, priors, sizeof(priors));
+
+        ok = fwrite(&header, sizeof(header), 1, file) == 1;
+        for (uint64_t i = 0; ok && i <= blockCount; i++) {
+            unsigned char entry[8];
+            for (int k = 0; k < 8; k++) entry[k] = (unsigned char)(offsets[i] >> (8 * k));
+            ok = fwrite(entry, 1, 8, file) == 8;
+        }
+        if (ok && data.size) ok = fwrite(data.data, 1, data.size, file) == data.size;
+        if (fclose(file) != 0) ok = false;
+        if (!ok) remove(path);
+    } else {
+        ok = false;
+    }
+
+    if (!ok) TraceLog(LOG_WARNING, "Failed to write compressed maze %s", path);
+    free(offsets);
+    free(bits);
+    free(data.data);
+    return ok;
+}
+
+// Helper: Find a block in the cache, decoding it (and evicting the least
+// recently used block) on a miss
+static const BlockSlot* AcquireBlock(BlockCache* cache, int bx, int by) {
+    cache->tick++;
+    cache->stats.lookups++;
+
+    size_t b = (size_t)by * cache->blocksX + bx;
+    int hit = cache->blockSlot[b];
+    if (hit >= 0) {
+        cache->slots[hit].lastUse = cache->tick;
+        return &cache->slots[hit];
+    }
+
+    // Miss: reuse an empty slot or the least recently used one
+    int victim = 0;
+    for (int i = 1; i < cache->slotCount && cache->slots[victim].lastUse > 0; i++) {
+        if (cache->slots[i].lastUse < cache->slots[victim].lastUse) victim = i;
+    }
+
+    BlockSlot* slot = &cache->slots[victim];
+    if (slot->bx >= 0) {
+        cache->blockSlot[(size_t)slot->by * cache->blocksX + slot->bx] = -1;
+        cache->stats.evictions++;
+    } else {
+        cache->stats.resident++;
+    }
+    cache->blockSlot[b] = victim;
+    slot->bx = bx;
+    slot->by = by;
+    slot->w = cache->width - bx * COMPRESSED_MAZE_BLOCK;
+    slot->h = cache->height - by * COMPRESSED_MAZE_BLOCK;
+    if (slot->w > COMPRESSED_MAZE_BLOCK) slot->w = COMPRESSED_MAZE_BLOCK;
+    if (slot->h > COMPRESSED_MAZE_BLOCK) slot->h = COMPRESSED_MAZE_BLOCK;
+    slot->lastUse = cache->tick;
+
+    uint64_t begin = IndexEntry(cache->index, b);
+    uint64_t end = IndexEntry(cache->index, b + 1);
+    DecodeBlock(cache->blocks + begin, (size_t)(end - begin), slot->bits, slot->w, slot->h, cache->priors);
+    cache->stats.decoded++;
+    return slot;
+}
+
+// Helper: Edge pair of an in-bounds cell
+static unsigned int CellEdges(BlockCache* cache, int x, int y) {
+    const BlockSlot* slot = AcquireBlock(cache, x / COMPRESSED_MAZE_BLOCK, y / COMPRESSED_MAZE_BLOCK);
+    return slot->bits[(y % COMPRESSED_MAZE_BLOCK) * slot->w + x % COMPRESSED_MAZE_BLOCK];
+}
+
+// Helper: MazeSource callback
+static unsigned char CompressedGetCell(void* user, int x, int y) {
+    BlockCache* cache = (BlockCache*)user;
+    unsigned int own = CellEdges(cache, x, y);
+    unsigned char cell = 0;
+    if (own & MAZE_PACKED_NORTH) cell |= MAZE_NORTH;
+    if (own & MAZE_PACKED_WEST) cell |= MAZE_WEST;
+    if (x + 1 == cache->width || (CellEdges(cache, x + 1, y) & MAZE_PACKED_WEST)) cell |= MAZE_EAST;
+    if (y + 1 == cache->height || (CellEdges(cache, x, y + 1) & MAZE_PACKED_NORTH)) cell |= MAZE_SOUTH;
+    return cell;
+}
+
+// Helper: MazeSource callback; east and south walls live in the neighbour,
+// so only one block is touched per query
+static bool CompressedHasWall(void* user, int x, int y, int direction) {
+    BlockCache* cache = (BlockCache*)user;
+    switch (direction) {
+        case MAZE_NORTH: return (CellEdges(cache, x, y) & MAZE_PACKED_NORTH) != 0;
+        case MAZE_WEST: return (CellEdges(cache, x, y) & MAZE_PACKED_WEST) != 0;
+        case MAZE_EAST: return x + 1 == cache->width || (CellEdges(cache, x + 1, y) & MAZE_PACKED_WEST);
+        case MAZE_SOUTH: return y + 1 == cache->height || (CellEdges(cache, x, y + 1) & MAZE_PACKED_NORTH);
+        default: return (CompressedGetCell(user, x, y) & direction) != 0;
+    }
+}
+
+// Helper: MazeSource callback
+static void CompressedDestroy(void* user) {
+    BlockCache* cache = (BlockCache*)user;
+    if (!cache) return;
+    free(cache->file);
+    free(cache->slots);
+    free(cache->blockSlot);
+    free(cache->store);
+    free(cache);
+}
+
+// Open a compressed maze container. The compressed blocks stay in memory
+// and cells are decoded a block at a time into an LRU of cacheBlocks
+// blocks (COMPRESSED_MAZE_CACHE if 0), so every Maze_* query works on it
+// unchanged. Row-by-row scans of a wide maze need about two rows of
+// blocks cached, or every cell costs a block decode.
+Maze* CompressedMaze_Open(const char* path, int cacheBlocks) {
+    FILE* file = path ? fopen(path, "rb") : NULL;
+    if (!file) {
+        TraceLog(LOG_WARNING, "Could not open compressed maze %s", path ? path : "(null)");
+        return NULL;
+    }
+
+    BlockCache* cache = (BlockCache*)calloc(1, sizeof(BlockCache));
+    long size = -1;
+    if (cache && fseek(file, 0, SEEK_END) == 0) size = ftell(file);
+    if (size > 0 && fseek(file, 0, SEEK_SET) == 0) cache->file = (unsigned char*)malloc((size_t)size);
+    bool ok = cache && cache->file && fread(cache->file, 1, (size_t)size, file) == (size_t)size;
+    fclose(file);
+
+    // Validate the header and the index before trusting any offset
+    ContainerHeader header;
+    if (ok) {
+        cache->fileSize = (size_t)size;
+        ok = cache->fileSize >= sizeof(header);
+    }
+    if (ok) {
+        memcpy(&header, cache->file, sizeof(header));
+        ok = memcmp(header.magic, CONTAINER_MAGIC, 4) == 0 && header.version == CONTAINER_VERSION &&
+             header.blockSize == COMPRESSED_MAZE_BLOCK && header.width >= 1 && header.height >= 1 &&
+             header.width <= 0x7FFFFFFF && header.height <= 0x7FFFFFFF &&
+             header.cellSize > 0.0f && isfinite(header.cellSize);
+    }
+    if (ok) {
+        cache->width = (int)header.width;
+        cache->height = (int)header.height;
+        for (int i = 0; i < CONTEXT_COUNT; i++) {
+            ok = ok && header.priors[i] > 0 && header.priors[i] < PROB_ONE;
+            cache->priors[i] = header.priors[i];
+        }
+        cache->blocksX = (cache->width + COMPRESSED_MAZE_BLOCK - 1) / COMPRESSED_MAZE_BLOCK;
+        cache->blocksY = (cache->height + COMPRESSED_MAZE_BLOCK - 1) / COMPRESSED_MAZE_BLOCK;
+        uint64_t indexSize = ((uint64_t)cache->blocksX * cache->blocksY + 1) * 8;
+        ok = header.blockCount == (uint64_t)cache->blocksX * cache->blocksY &&
+             indexSize <= cache->fileSize - sizeof(header);
+        if (ok) {
+            cache->index = cache->file + sizeof(header);
+            cache->blocks = cache->index + indexSize;
+            cache->blocksSize = cache->fileSize - sizeof(header) - (size_t)indexSize;
+            uint64_t previous = 0;
+            for (uint64_t i = 0; ok && i <= header.blockCount; i++) {
+                uint64_t offset = IndexEntry(cache->index, i);
+                ok = offset >= previous && offset <= cache->blocksSize;
+                previous = offset;
+            }
+        }
+    }
+
+    if (ok) {
+        size_t blockCount = (size_t)cache->blocksX * cache->blocksY;
+        cache->slotCount = cacheBlocks > 0 ? cacheBlocks : COMPRESSED_MAZE_CACHE;
+        if ((size_t)cache->slotCount > blockCount) cache->slotCount = (int)blockCount;
+        cache->slots = (BlockSlot*)calloc((size_t)cache->slotCount, sizeof(BlockSlot));
+        cache->blockSlot = (int*)malloc(blockCount * sizeof(int));
+        cache->store = (unsigned char*)malloc((size_t)cache->slotCount * COMPRESSED_MAZE_BLOCK * COMPRESSED_MAZE_BLOCK);
+        ok = cache->slots && cache->blockSlot && cache->store;
+        for (size_t i = 0; ok && i < blockCount; i++) cache->blockSlot[i] = -1;
+    }
+    if (!ok) {
+        TraceLog(LOG_WARNING, "%s is not a valid compressed maze", path);
+        CompressedDestroy(cache);
+        return NULL;
+    }
+
+    for (int i = 0; i < cache->slotCount; i++) {
+        cache->slots[i].bx = cache->slots[i].by = -1;
+        cache->slots[i].bits = &cache->store[(size_t)i * COMPRESSED_MAZE_BLOCK * COMPRESSED_MAZE_BLOCK];
+    }
+    cache->stats.rawBytes = MAZE_PACKED_STRIDE(cache->width) * (size_t)cache->height;
+    cache->stats.compressedBytes = cache->fileSize;
+
+    MazeSource source = {CompressedGetCell, CompressedDestroy, cache, CompressedHasWall};
+    Maze* maze = Maze_CreateWithSource(cache->width, cache->height, header.cellSize, source);
+    if (!maze) {
+        CompressedDestroy(cache);
+        return NULL;
+    }
+    maze->startPos = (Vector2){header.startX, header.startY};
+    maze->exitPos = (Vector2){header.exitX, header.exitY};
+    maze->seed = header.seed;
+    return maze;
+}
+
+// Check whether a maze is served from a compressed container
+bool CompressedMaze_Is(const Maze* maze) {
+    return maze && !maze->cells && !maze->edges && maze->source.getCell == CompressedGetCell;
+}
+
+// Cache and size counters (all zero for other mazes)
+CompressedMazeStats CompressedMaze_GetStats(const Maze* maze) {
+    CompressedMazeStats stats = {0};
+    if (CompressedMaze_Is(maze)) stats = ((const BlockCache*)maze->source.user)->stats;
+    return stats;
+}
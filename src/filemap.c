@@ -0,0 +1,55 @@
+#define _POSIX_C_SOURCE 200809L
+#include "../include/filemap.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+// No mmap: the fallback reads the whole file into one heap block, which is
+// then owned the same way a mapping would be
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Map a whole file copy-on-write; NULL if it is missing or empty
+void* FileMap_Open(const char* path, size_t* outSize) {
+#ifdef _WIN32
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+    void* view = NULL;
+    long size = -1;
+    if (fseek(file, 0, SEEK_END) == 0) size = ftell(file);
+    if (size > 0 && fseek(file, 0, SEEK_SET) == 0) view = malloc((size_t)size);
+    if (view && fread(view, 1, (size_t)size, file) != (size_t)size) {
+        free(view);
+        view = NULL;
+    }
+    fclose(file);
+    *outSize = view ? (size_t)size : 0;
+    return view;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    void* view = NULL;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        view = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED) view = NULL;
+    }
+    close(fd);  // The mapping keeps the file alive
+    *outSize = view ? (size_t)st.st_size : 0;
+    return view;
+#endif
+}
+
+// Release a view from FileMap_Open
+void FileMap_Close(void* view, size_t size) {
+#ifdef _WIN32
+    (void)size;
+    free(view);
+#else
+    munmap(view, size);
+#endif
+}
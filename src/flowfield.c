@@ -0,0 +1,140 @@
+#include "../include/flowfield.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Direction tables (same order as the maze generator)
+static const int s_dirs[4] = {MAZE_NORTH, MAZE_EAST, MAZE_SOUTH, MAZE_WEST};
+static const int s_dx[4] = {0, 1, 0, -1};
+static const int s_dy[4] = {-1, 0, 1, 0};
+
+// Helper: Direction that undoes dir
+static int OppositeDir(int dir) {
+    switch (dir) {
+        case MAZE_NORTH: return MAZE_SOUTH;
+        case MAZE_EAST:  return MAZE_WEST;
+        case MAZE_SOUTH: return MAZE_NORTH;
+        default:         return MAZE_EAST;
+    }
+}
+
+// Helper: Step one cell in a MAZE_* direction
+static void StepDir(int dir, int* x, int* y) {
+    for (int i = 0; i < 4; i++) {
+        if (s_dirs[i] == dir) {
+            *x += s_dx[i];
+            *y += s_dy[i];
+            return;
+        }
+    }
+}
+
+// Create an empty field sized for the maze
+FlowField* FlowField_Create(const Maze* maze) {
+    if (!maze) return NULL;
+    
+    FlowField* field = (FlowField*)calloc(1, sizeof(FlowField));
+    if (!field) return NULL;
+    
+    size_t cellCount = (size_t)maze->width * maze->height;
+    field->width = maze->width;
+    field->height = maze->height;
+    field->toward = (unsigned char*)calloc(cellCount, sizeof(unsigned char));
+    field->queue = (int*)malloc(cellCount * sizeof(int));
+    field->targetX = -1;
+    field->targetY = -1;
+    
+    if (!field->toward || !field->queue) {
+        FlowField_Destroy(field);
+        return NULL;
+    }
+    return field;
+}
+
+// Destroy field and free memory
+void FlowField_Destroy(FlowField* field) {
+    if (!field) return;
+    free(field->toward);
+    free(field->queue);
+    free(field);
+}
+
+// Rebuild the whole field with a BFS from the target cell
+void FlowField_Build(FlowField* field, const Maze* maze, int targetX, int targetY) {
+    if (!field || !maze) return;
+    if (targetX < 0 || targetX >= field->width || targetY < 0 || targetY >= field->height) return;
+    
+    const int width = field->width;
+    size_t cellCount = (size_t)width * field->height;
+    memset(field->toward, 0, cellCount);
+    
+    // toward == 0 doubles as "unvisited"; the target is the only visited cell
+    // left at 0, so track it by index
+    int target = targetY * width + targetX;
+    int head = 0, tail = 0;
+    int openEdges = 0;
+    field->queue[tail++] = target;
+    
+    while (head < tail) {
+        int idx = field->queue[head++];
+        int x = idx % width;
+        int y = idx / width;
+        
+        for (int i = 0; i < 4; i++) {
+            if (Maze_HasWall(maze, x, y, s_dirs[i])) continue;
+            openEdges++;
+            
+            int nx = x + s_dx[i];
+            int ny = y + s_dy[i];
+            int nidx = ny * width + nx;
+            if (nidx == target || field->toward[nidx]) continue;
+            
+            // The neighbour's next step leads back to this cell
+            field->toward[nidx] = (unsigned char)OppositeDir(s_dirs[i]);
+            field->queue[tail++] = nidx;
+        }
+    }
+    
+    // Each open edge was seen from both sides
+    field->isTree = ((size_t)tail == cellCount && openEdges / 2 == tail - 1);
+    field->targetX = targetX;
+    field->targetY = targetY;
+    field->rebuilds++;
+}
+
+// Move the target. In a perfect maze only the pointers on the path between
+// the old and new target flip (one cell for an adjacent move); otherwise the
+// field is rebuilt.
+void FlowField_SetTarget(FlowField* field, const Maze* maze, int targetX, int targetY) {
+    if (!field || !maze) return;
+    if (targetX < 0 || targetX >= field->width || targetY < 0 || targetY >= field->height) return;
+    if (targetX == field->targetX && targetY == field->targetY) return;
+    
+    if (!field->isTree || field->targetX < 0) {
+        FlowField_Build(field, maze, targetX, targetY);
+        return;
+    }
+    
+    // Re-root: walk from the new target to the old one, reversing each step
+    const int width = field->width;
+    int x = targetX, y = targetY;
+    int dir = field->toward[y * width + x];
+    field->toward[y * width + x] = 0;
+    
+    while (dir) {
+        StepDir(dir, &x, &y);
+        int idx = y * width + x;
+        int next = field->toward[idx];
+        field->toward[idx] = (unsigned char)OppositeDir(dir);
+        dir = next;
+    }
+    
+    field->targetX = targetX;
+    field->targetY = targetY;
+    field->repairs++;
+}
+
+// Next-step direction from a cell (0 at the target or outside the field)
+int FlowField_Direction(const FlowField* field, int x, int y) {
+    if (!field || x < 0 || x >= field->width || y < 0 || y >= field->height) return 0;
+    return field->toward[y * field->width + x];
+}
@@ -0,0 +1,42 @@
+#include "../include/heapcheck.h"
+#include <stddef.h>
+#include <stdlib.h>
+
+#if defined(__GLIBC__) && !defined(NDEBUG)
+
+// The executable's malloc family interposes the C library's for every
+// caller in the process (raylib and the GL driver included) and forwards
+// to glibc's own entry points. The count is per thread so background
+// level builds do not show up in the frame loop's numbers.
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+
+static _Thread_local long long s_allocations;
+
+void* malloc(size_t size) {
+    s_allocations++;
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    s_allocations++;
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    s_allocations++;
+    return __libc_realloc(ptr, size);
+}
+
+long long HeapCheck_Allocations(void) {
+    return s_allocations;
+}
+
+#else
+
+long long HeapCheck_Allocations(void) {
+    return -1;
+}
+
+#endif
@@ -0,0 +1,157 @@
+#include "../include/level.h"
+#include "../include/rng.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Worker state for one background level build
+struct LevelPrefetch {
+    LevelSettings settings;
+    uint64_t seed;
+    Arena* arena;               // Lent to the worker until LevelPrefetch_Finish
+    pthread_t thread;
+    bool threaded;              // False if the thread could not be started
+    _Atomic(Level*) ready;      // Published by the worker once the level is complete
+};
+
+// Helper: Wall-clock seconds
+static double Now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Build the CPU side of a generated level: the maze, its merged walls, the
+// wall mesh bake, torches, the pursuit field and the culling state. Touches
+// no GPU state, so it may run on any thread. The arena must outlive the
+// level; resetting it is what frees the level.
+Level* Level_Build(const LevelSettings* settings, uint64_t seed, Arena* arena) {
+    if (!settings || !arena) return NULL;
+    double start = Now();
+
+    Level* level = (Level*)Arena_Calloc(arena, 1, sizeof(Level));
+    if (!level) return NULL;
+    level->seed = seed;
+    level->arena = arena;
+
+    level->maze = Maze_CreateIn(arena, settings->width, settings->height, settings->cellSize,
+                                settings->packed ? MAZE_STORAGE_PACKED : MAZE_STORAGE_BYTES);
+    if (!level->maze) {
+        TraceLog(LOG_ERROR, "Failed to create %dx%d maze!", settings->width, settings->height);
+        return NULL;
+    }
+    Maze* maze = level->maze;
+
+    maze->seed = seed;
+    Rng mazeRng = Rng_ForStream(seed, RNG_STREAM_MAZE, 0);
+    if (settings->generatorThreads > 0) {
+        Maze_GenerateParallel(maze, settings->algorithm, &mazeRng, settings->generatorThreads, MAZE_PARALLEL_TILE);
+#ifndef NDEBUG
+        if (!Maze_IsPerfect(maze)) TraceLog(LOG_WARNING, "Tiled maze is not a spanning tree!");
+#endif
+    } else {
+        Maze_GenerateWith(maze, settings->algorithm, &mazeRng);
+    }
+
+    // Each physical wall once, collinear runs merged. Room for one run per
+    // lattice edge, trimmed to the real count.
+    size_t maxWalls = (size_t)settings->width * settings->height * 2 + settings->width + settings->height;
+    level->walls = maxWalls <= 0x7FFFFFFF ? (WallRect*)Arena_Alloc(arena, maxWalls * sizeof(WallRect)) : NULL;
+    if (!level->walls) {
+        TraceLog(LOG_ERROR, "Failed to allocate wall rectangles!");
+        Level_Destroy(level);
+        return NULL;
+    }
+    level->wallCount = Maze_GetMergedWallRects(maze, level->walls, (int)maxWalls);
+    Arena_Shrink(arena, level->walls, (size_t)level->wallCount * sizeof(WallRect));
+
+    if (!MazeMesh_Bake(maze, level->walls, level->wallCount, settings->wallHeight, settings->wallThick,
+                       &level->mesh)) {
+        TraceLog(LOG_ERROR, "Failed to bake wall mesh!");
+    }
+
+    // Sparse random torch placement for a scary atmosphere
+    if (settings->maxTorches > 0) {
+        level->torches = (Torch*)Arena_Alloc(arena, (size_t)settings->maxTorches * sizeof(Torch));
+        Rng torchRng = Rng_ForStream(seed, RNG_STREAM_TORCHES, 0);
+        level->torchCount = Torches_Generate(maze, level->walls, level->wallCount, level->torches,
+                                             settings->maxTorches, &torchRng);
+    }
+
+    // Chasers path towards the player through this field
+    level->flowField = FlowField_Create(maze);
+    FlowField_Build(level->flowField, maze, (int)maze->startPos.x, (int)maze->startPos.y);
+
+    level->portalCuller = PortalCuller_Create(maze);
+    level->visibleCells = VisibleSet_Create(maze);
+
+    level->buildSeconds = Now() - start;
+    return level;
+}
+
+// Free whatever the level still owns outside its arena
+void Level_Destroy(Level* level) {
+    if (!level) return;
+    if (level->maze) Maze_Destroy(level->maze);
+    MazeMesh_FreeBake(&level->mesh);
+    if (level->flowField) FlowField_Destroy(level->flowField);
+    if (level->portalCuller) PortalCuller_Destroy(level->portalCuller);
+    if (level->visibleCells) VisibleSet_Destroy(level->visibleCells);
+    level->maze = NULL;
+    level->flowField = NULL;
+    level->portalCuller = NULL;
+    level->visibleCells = NULL;
+}
+
+// Helper: Worker thread body
+static void* PrefetchWorker(void* arg) {
+    LevelPrefetch* prefetch = (LevelPrefetch*)arg;
+    Level* level = Level_Build(&prefetch->settings, prefetch->seed, prefetch->arena);
+    atomic_store_explicit(&prefetch->ready, level, memory_order_release);
+    return NULL;
+}
+
+// Start building a level on its own thread while the current one is played.
+// The arena is reset and lent to the worker, which writes nothing but the
+// new level and that arena, and publishes the level with a single atomic
+// store, so the game never locks to check on it.
+LevelPrefetch* LevelPrefetch_Start(const LevelSettings* settings, uint64_t seed, Arena* arena) {
+    if (!settings || !arena) return NULL;
+
+    LevelPrefetch* prefetch = (LevelPrefetch*)calloc(1, sizeof(LevelPrefetch));
+    if (!prefetch) return NULL;
+    prefetch->settings = *settings;
+    prefetch->seed = seed;
+    prefetch->arena = arena;
+    Arena_Reset(arena);
+    atomic_init(&prefetch->ready, NULL);
+
+    // Without a thread the level is built when it is asked for
+    prefetch->threaded = pthread_create(&prefetch->thread, NULL, PrefetchWorker, prefetch) == 0;
+    if (!prefetch->threaded) TraceLog(LOG_WARNING, "Could not start the level prefetch thread");
+    return prefetch;
+}
+
+// Check, without waiting, whether the level has been published
+bool LevelPrefetch_IsReady(LevelPrefetch* prefetch) {
+    return prefetch && atomic_load_explicit(&prefetch->ready, memory_order_acquire) != NULL;
+}
+
+// Take the level, waiting for the worker if it is still building (or
+// building it here if no thread was started), and free the prefetch.
+// Returns NULL only if the build failed.
+Level* LevelPrefetch_Finish(LevelPrefetch* prefetch) {
+    if (!prefetch) return NULL;
+
+    if (prefetch->threaded) {
+        pthread_join(prefetch->thread, NULL);
+    } else {
+        Level* level = Level_Build(&prefetch->settings, prefetch->seed, prefetch->arena);
+        atomic_store_explicit(&prefetch->ready, level, memory_order_release);
+    }
+
+    Level* level = atomic_exchange_explicit(&prefetch->ready, NULL, memory_order_acquire);
+    free(prefetch);
+    return level;
+}
@@ -0,0 +1,297 @@
+#include "../include/levelpack.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Pack layout: a complete maze file (header, payload), then a directory at
+// the next 64-byte boundary, then every section at a 64-byte boundary.
+// Sections hold the in-memory arrays verbatim, so opening a pack is one
+// mapping plus a validation pass; nothing is parsed or rebuilt.
+#define PACK_ALIGN 64
+
+typedef enum {
+    SECTION_WALLS,
+    SECTION_MESH_CHUNKS,
+    SECTION_WALL_CHUNK,
+    SECTION_WALL_FIRST_INDEX,
+    SECTION_WALL_INDEX_COUNT,
+    SECTION_HORIZONTAL_EDGES,
+    SECTION_VERTICAL_EDGES,
+    SECTION_VERTICES,
+    SECTION_TEXCOORDS,
+    SECTION_INDICES,
+    SECTION_PVS_BOXES,
+    SECTION_PVS_OFFSETS,
+    SECTION_PVS_BITS,
+    SECTION_TORCHES,
+    SECTION_COUNT
+} PackSection;
+
+typedef struct {
+    char magic[4];              // LEVEL_PACK_MAGIC
+    uint32_t version;           // LEVEL_PACK_VERSION
+    float wallHeight;
+    float wallThick;
+    uint64_t pvsBitCount;       // 0 if the pack has no PVS
+    int64_t pvsTotalVisible;
+    uint64_t offsets[SECTION_COUNT];    // Absolute file offsets
+    uint64_t sizes[SECTION_COUNT];      // Section sizes in bytes
+} PackDirectory;
+
+// Helper: Round up to the section alignment
+static uint64_t AlignPack(uint64_t offset) {
+    return (offset + PACK_ALIGN - 1) & ~(uint64_t)(PACK_ALIGN - 1);
+}
+
+// Helper: Zero padding from offset up to the next section boundary
+static bool WritePadding(FILE* file, uint64_t offset) {
+    static const unsigned char padding[PACK_ALIGN] = {0};
+    size_t count = (size_t)(AlignPack(offset) - offset);
+    return fwrite(padding, 1, count, file) == count;
+}
+
+// Bake a level pack: the maze file, then its merged walls, the chunked wall
+// mesh, the PVS (optional, it grows quickly with maze size) and the torches
+// the game would place from the maze's seed
+bool LevelPack_Bake(const Maze* maze, const char* path, float wallHeight, float wallThick, int maxTorches,
+                    bool withPvs) {
+    if (!maze || !path || !Maze_Save(maze, path)) return false;
+
+    MazeFileHeader header;
+    if (!Maze_ReadFileHeader(path, &header)) return false;
+
+    size_t maxWalls = (size_t)maze->width * maze->height * 2 + maze->width + maze->height;
+    WallRect* walls = maxWalls <= 0x7FFFFFFF ? (WallRect*)malloc(maxWalls * sizeof(WallRect)) : NULL;
+    int wallCount = walls ? Maze_GetMergedWallRects(maze, walls, (int)maxWalls) : 0;
+
+    MazeMeshBake mesh = {0};
+    bool ok = walls && MazeMesh_Bake(maze, walls, wallCount, wallHeight, wallThick, &mesh);
+    Pvs* pvs = ok && withPvs ? Pvs_Build(maze) : NULL;
+    ok = ok && (pvs || !withPvs);
+
+    Torch* torches = NULL;
+    int torchCount = 0;
+    if (ok && maxTorches > 0) {
+        torches = (Torch*)malloc((size_t)maxTorches * sizeof(Torch));
+        Rng torchRng = Rng_ForStream(maze->seed, RNG_STREAM_TORCHES, 0);
+        torchCount = Torches_Generate(maze, walls, wallCount, torches, maxTorches, &torchRng);
+    }
+
+    const size_t cellCount = (size_t)maze->width * maze->height;
+    const void* data[SECTION_COUNT] = {
+        walls, mesh.chunks, mesh.wallChunk, mesh.wallFirstIndex, mesh.wallIndexCount,
+        mesh.horizontalEdgeWall, mesh.verticalEdgeWall, mesh.vertices, mesh.texcoords, mesh.indices,
+        pvs ? pvs->boxes : NULL, pvs ? pvs->bitOffsets : NULL, pvs ? pvs->bits : NULL, torches
+    };
+    PackDirectory directory = {0};
+    memcpy(directory.magic, LEVEL_PACK_MAGIC, 4);
+    directory.version = LEVEL_PACK_VERSION;
+    directory.wallHeight = wallHeight;
+    directory.wallThick = wallThick;
+    directory.sizes[SECTION_WALLS] = (uint64_t)wallCount * sizeof(WallRect);
+    directory.sizes[SECTION_MESH_CHUNKS] = (uint64_t)mesh.chunkCount * sizeof(MazeMeshBakeChunk);
+    directory.sizes[SECTION_WALL_CHUNK] = (uint64_t)mesh.pieceCount * sizeof(int);
+    directory.sizes[SECTION_WALL_FIRST_INDEX] = (uint64_t)mesh.pieceCount * sizeof(int);
+    directory.sizes[SECTION_WALL_INDEX_COUNT] = (uint64_t)mesh.pieceCount;
+    directory.sizes[SECTION_HORIZONTAL_EDGES] = (uint64_t)maze->width * (maze->height + 1) * sizeof(int);
+    directory.sizes[SECTION_VERTICAL_EDGES] = (uint64_t)(maze->width + 1) * maze->height * sizeof(int);
+    directory.sizes[SECTION_VERTICES] = (uint64_t)mesh.quadCount * 4 * 3 * sizeof(float);
+    directory.sizes[SECTION_TEXCOORDS] = (uint64_t)mesh.quadCount * 4 * 2 * sizeof(float);
+    directory.sizes[SECTION_INDICES] = (uint64_t)mesh.quadCount * 6 * sizeof(unsigned short);
+    if (pvs) {
+        directory.pvsBitCount = pvs->bitCount;
+        directory.pvsTotalVisible = pvs->totalVisible;
+        directory.sizes[SECTION_PVS_BOXES] = (uint64_t)cellCount * 4 * sizeof(int);
+        directory.sizes[SECTION_PVS_OFFSETS] = (uint64_t)cellCount * sizeof(size_t);
+        directory.sizes[SECTION_PVS_BITS] = (pvs->bitCount + 31) / 32 * sizeof(uint32_t);
+    }
+    directory.sizes[SECTION_TORCHES] = (uint64_t)torchCount * sizeof(Torch);
+
+    uint64_t directoryOffset = AlignPack(header.payloadOffset + header.payloadSize);
+    uint64_t offset = directoryOffset + sizeof(directory);
+    for (int i = 0; i < SECTION_COUNT; i++) {
+        directory.offsets[i] = AlignPack(offset);
+        offset = directory.offsets[i] + directory.sizes[i];
+    }
+
+    // Append to the maze file written above
+    FILE* file = ok ? fopen(path, "ab") : NULL;
+    if (file) {
+        offset = header.payloadOffset + header.payloadSize;
+        ok = WritePadding(file, offset) && fwrite(&directory, sizeof(directory), 1, file) == 1;
+        offset = directoryOffset + sizeof(directory);
+        for (int i = 0; ok && i < SECTION_COUNT; i++) {
+            ok = WritePadding(file, offset);
+            if (ok && directory.sizes[i]) ok = fwrite(data[i], 1, (size_t)directory.sizes[i], file) == directory.sizes[i];
+            offset = directory.offsets[i] + directory.sizes[i];
+        }
+        if (fclose(file) != 0) ok = false;
+    } else {
+        ok = false;
+    }
+
+    if (!ok) {
+        TraceLog(LOG_WARNING, "Failed to write level pack %s", path);
+        remove(path);
+    }
+    free(walls);
+    free(torches);
+    MazeMesh_FreeBake(&mesh);
+    Pvs_Destroy(pvs);
+    return ok;
+}
+
+// Helper: Section as an array of count elements, or NULL if it lies outside
+// the file or is not a whole number of elements
+static void* SectionView(unsigned char* view, size_t viewSize, const PackDirectory* directory, int section,
+                         size_t elementSize, size_t count) {
+    uint64_t offset = directory->offsets[section];
+    uint64_t size = directory->sizes[section];
+    if (offset % PACK_ALIGN != 0 || offset > viewSize || size > viewSize - offset) return NULL;
+    if (size != (uint64_t)count * elementSize) return NULL;
+    return view + offset;
+}
+
+// Helper: Check that every index the mesh tables hold stays inside its
+// arrays, so a damaged pack cannot make a draw read out of bounds
+static bool ValidMesh(const MazeMeshBake* mesh) {
+    const size_t hEdges = (size_t)mesh->width * (mesh->height + 1);
+    const size_t vEdges = (size_t)(mesh->width + 1) * mesh->height;
+    for (size_t i = 0; i < hEdges; i++) {
+        if (mesh->horizontalEdgeWall[i] < -1 || mesh->horizontalEdgeWall[i] >= mesh->pieceCount) return false;
+    }
+    for (size_t i = 0; i < vEdges; i++) {
+        if (mesh->verticalEdgeWall[i] < -1 || mesh->verticalEdgeWall[i] >= mesh->pieceCount) return false;
+    }
+
+    for (int c = 0; c < mesh->chunkCount; c++) {
+        const MazeMeshBakeChunk* chunk = &mesh->chunks[c];
+        if (chunk->firstWall < 0 || chunk->wallCount < 0 || chunk->wallCount > mesh->pieceCount - chunk->firstWall) return false;
+        if (chunk->firstQuad < 0 || chunk->quadCount < 0 || chunk->quadCount > mesh->quadCount - chunk->firstQuad) return false;
+        if (chunk->quadCount > 65536 / 4) return false;     // 16-bit indices
+
+        // Culled draws gather each piece once per frame into a buffer the
+        // size of the chunk's index list
+        int indexCount = chunk->quadCount * 6;
+        int gathered = 0;
+        for (int i = chunk->firstWall; i < chunk->firstWall + chunk->wallCount; i++) {
+            if (mesh->wallChunk[i] != c || mesh->wallFirstIndex[i] < 0 ||
+                mesh->wallFirstIndex[i] > indexCount - mesh->wallIndexCount[i]) return false;
+            gathered += mesh->wallIndexCount[i];
+        }
+        if (gathered > indexCount) return false;
+
+        const unsigned short* indices = &mesh->indices[(size_t)chunk->firstQuad * 6];
+        for (int i = 0; i < indexCount; i++) {
+            if (indices[i] >= chunk->quadCount * 4) return false;
+        }
+    }
+
+    // Every piece must lie in the range of the chunk it names (which, with
+    // the check above, makes the per-chunk sums cover every piece)
+    for (int i = 0; i < mesh->pieceCount; i++) {
+        int c = mesh->wallChunk[i];
+        if (c < 0 || c >= mesh->chunkCount || i < mesh->chunks[c].firstWall ||
+            i >= mesh->chunks[c].firstWall + mesh->chunks[c].wallCount) return false;
+    }
+    return true;
+}
+
+// Helper: Check that every PVS bitset lies inside the maze and the bit array
+static bool ValidPvs(const Pvs* pvs) {
+    const size_t cellCount = (size_t)pvs->width * pvs->height;
+    for (size_t cell = 0; cell < cellCount; cell++) {
+        const int* box = &pvs->boxes[cell * 4];
+        if (box[0] < 0 || box[1] < 0 || box[2] < 0 || box[3] < 0 || box[2] > pvs->width - box[0] ||
+            box[3] > pvs->height - box[1]) return false;
+        if (pvs->bitOffsets[cell] > pvs->bitCount ||
+            (size_t)box[2] * box[3] > pvs->bitCount - pvs->bitOffsets[cell]) return false;
+    }
+    return true;
+}
+
+// Open a level pack. The maze is mapped like any maze file and the other
+// sections are used in place from the same mapping: loading a level costs
+// the mapping and a bounds check of the tables, nothing is rebuilt.
+// Release everything with Maze_Destroy on the returned maze.
+Maze* LevelPack_Open(const char* path, LevelPack* outPack) {
+    if (!outPack) return NULL;
+    *outPack = (LevelPack){0};
+
+    Maze* maze = Maze_Map(path);
+    if (!maze) return NULL;
+
+    unsigned char* view = (unsigned char*)maze->mapping;
+    const size_t viewSize = maze->mappingSize;
+    const MazeFileHeader* header = (const MazeFileHeader*)view;
+    uint64_t directoryOffset = AlignPack(header->payloadOffset + header->payloadSize);
+
+    PackDirectory directory;
+    bool ok = directoryOffset <= viewSize && sizeof(directory) <= viewSize - directoryOffset;
+    if (ok) {
+        memcpy(&directory, view + directoryOffset, sizeof(directory));
+        ok = memcmp(directory.magic, LEVEL_PACK_MAGIC, 4) == 0 && directory.version == LEVEL_PACK_VERSION &&
+             directory.wallHeight > 0.0f && directory.wallThick > 0.0f && directory.wallThick < maze->cellSize;
+    }
+
+    LevelPack* pack = outPack;
+    MazeMeshBake* mesh = &pack->mesh;
+    const size_t cellCount = (size_t)maze->width * maze->height;
+    if (ok) {
+        pack->wallHeight = directory.wallHeight;
+        pack->wallThick = directory.wallThick;
+        pack->wallCount = (int)(directory.sizes[SECTION_WALLS] / sizeof(WallRect));
+        pack->torchCount = (int)(directory.sizes[SECTION_TORCHES] / sizeof(Torch));
+        mesh->width = maze->width;
+        mesh->height = maze->height;
+        mesh->chunkCount = ((maze->width + MAZE_CHUNK_CELLS - 1) / MAZE_CHUNK_CELLS) *
+                           ((maze->height + MAZE_CHUNK_CELLS - 1) / MAZE_CHUNK_CELLS);
+        mesh->pieceCount = (int)(directory.sizes[SECTION_WALL_INDEX_COUNT]);
+        mesh->quadCount = (int)(directory.sizes[SECTION_INDICES] / (6 * sizeof(unsigned short)));
+
+        pack->walls = SectionView(view, viewSize, &directory, SECTION_WALLS, sizeof(WallRect), pack->wallCount);
+        pack->torches = SectionView(view, viewSize, &directory, SECTION_TORCHES, sizeof(Torch), pack->torchCount);
+        mesh->chunks = SectionView(view, viewSize, &directory, SECTION_MESH_CHUNKS, sizeof(MazeMeshBakeChunk),
+                                   mesh->chunkCount);
+        mesh->wallChunk = SectionView(view, viewSize, &directory, SECTION_WALL_CHUNK, sizeof(int), mesh->pieceCount);
+        mesh->wallFirstIndex = SectionView(view, viewSize, &directory, SECTION_WALL_FIRST_INDEX, sizeof(int),
+                                           mesh->pieceCount);
+        mesh->wallIndexCount = SectionView(view, viewSize, &directory, SECTION_WALL_INDEX_COUNT, 1, mesh->pieceCount);
+        mesh->horizontalEdgeWall = SectionView(view, viewSize, &directory, SECTION_HORIZONTAL_EDGES, sizeof(int),
+                                               (size_t)maze->width * (maze->height + 1));
+        mesh->verticalEdgeWall = SectionView(view, viewSize, &directory, SECTION_VERTICAL_EDGES, sizeof(int),
+                                             (size_t)(maze->width + 1) * maze->height);
+        mesh->vertices = SectionView(view, viewSize, &directory, SECTION_VERTICES, 4 * 3 * sizeof(float),
+                                     (size_t)mesh->quadCount);
+        mesh->texcoords = SectionView(view, viewSize, &directory, SECTION_TEXCOORDS, 4 * 2 * sizeof(float),
+                                      (size_t)mesh->quadCount);
+        mesh->indices = SectionView(view, viewSize, &directory, SECTION_INDICES, 6 * sizeof(unsigned short),
+                                    (size_t)mesh->quadCount);
+        ok = pack->walls && pack->torches && mesh->chunks && mesh->wallChunk && mesh->wallFirstIndex &&
+             mesh->wallIndexCount && mesh->horizontalEdgeWall && mesh->verticalEdgeWall && mesh->vertices &&
+             mesh->texcoords && mesh->indices && ValidMesh(mesh);
+    }
+
+    // The PVS is optional; bit offsets are stored as 64-bit size_t
+    if (ok && directory.pvsBitCount > 0 && sizeof(size_t) == sizeof(uint64_t)) {
+        Pvs* pvs = &pack->pvs;
+        pvs->width = maze->width;
+        pvs->height = maze->height;
+        pvs->bitCount = (size_t)directory.pvsBitCount;
+        pvs->totalVisible = directory.pvsTotalVisible;
+        pvs->borrowed = true;
+        pvs->boxes = SectionView(view, viewSize, &directory, SECTION_PVS_BOXES, 4 * sizeof(int), cellCount);
+        pvs->bitOffsets = SectionView(view, viewSize, &directory, SECTION_PVS_OFFSETS, sizeof(size_t), cellCount);
+        pvs->bits = SectionView(view, viewSize, &directory, SECTION_PVS_BITS, sizeof(uint32_t),
+                                (pvs->bitCount + 31) / 32);
+        ok = pvs->boxes && pvs->bitOffsets && pvs->bits && ValidPvs(pvs);
+    }
+
+    if (!ok) {
+        TraceLog(LOG_WARNING, "%s is not a valid version %d level pack", path, LEVEL_PACK_VERSION);
+        *outPack = (LevelPack){0};
+        Maze_Destroy(maze);
+        return NULL;
+    }
+    return maze;
+}
@@ -1,11 +1,22 @@
 #include "raylib.h"
 #include "../include/maze.h"
 #include "../include/assets.h"
+#include "../include/mazemesh.h"
+#include "../include/rng.h"
+#include "../include/flowfield.h"
+#include "../include/visibility.h"
+#include "../include/levelpack.h"
+#include "../include/level.h"
+#include "../include/arena.h"
+#include "../include/heapcheck.h"
+#include "../include/texcache.h"
+#include "../include/texencode.h"
 #include <math.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <time.h>
 #include <stdio.h>
+#include <string.h>
 
 // Game Constants
 #define MAZE_WIDTH           15      // Number of cells horizontally
@@ -22,14 +33,54 @@
 #define RUN_MULTIPLIER       1.8f
 #define MOUSE_SENS           0.0020f // Radians per pixel
 
-#define SCARY_CHAR_COUNT     3       // Number of scary characters
+#define SCARY_CHAR_COUNT     3       // Default number of scary characters
 #define SCARY_CHAR_SPEED     2.8f    // Scary character movement speed
 #define SCARY_CHAR_RADIUS    0.35f   // Collision radius
 #define SCARY_CHAR_HEIGHT    2.2f    // Height of scary character
-#define SCARY_CHAR_RANDOMNESS 0.15f  // Randomness factor in movement
+
+#define MAX_TORCHES          25      // Torch budget per level
+#define PARTICLES_PER_TORCH  20
 
 #define BEST_RECORD_FILE     "best_record.txt"
 
+// Maze dimensions (overridable with --size WxH)
+static int s_mazeWidth = MAZE_WIDTH;
+static int s_mazeHeight = MAZE_HEIGHT;
+
+// Master seed (overridable with --seed N); every level and asset derives from it
+static uint64_t s_masterSeed = 0;
+
+// Procedural texture resolution (overridable with --texture-size N)
+static int s_textureSize = ASSET_TEXTURE_SIZE;
+
+// Generated textures are cached here (--texture-cache DIR, off with --no-texture-cache)
+static const char* s_textureCacheDir = TEXTURE_CACHE_DIR;
+
+// Encode textures to DXT1 (enabled with --compress-textures)
+static bool s_compressTextures = false;
+
+// Evaluate the surface patterns in a shader instead of generating textures
+// (enabled with --shader-materials)
+static bool s_shaderMaterials = false;
+
+// Generation algorithm (overridable with --algo NAME)
+static MazeAlgorithm s_mazeAlgorithm = MAZE_ALGO_BACKTRACKER;
+
+// Carve the maze in tiles on this many threads (--threads N, 0 = single pass)
+static int s_generatorThreads = 0;
+
+// Store the maze at 2 bits per cell (enabled with --packed)
+static bool s_packedMaze = false;
+
+// Play a saved maze file instead of generating one (--maze FILE)
+static const char* s_mazeFile = NULL;
+
+// Play a level pack baked by mazebake (--pack FILE)
+static const char* s_levelPackFile = NULL;
+
+// Number of chasers (overridable with --chasers N)
+static int s_chaserCount = SCARY_CHAR_COUNT;
+
 // Game state
 typedef enum {
     GAME_STATE_PLAYING,
@@ -37,6 +88,16 @@ typedef enum {
     GAME_STATE_GAMEOVER
 } GameState;
 
+// Render culling modes (cycled with V)
+typedef enum {
+    CULL_NONE,
+    CULL_PVS,       // Precomputed per-cell visibility
+    CULL_PORTAL,    // Runtime portal traversal with frustum narrowing
+    CULL_MODE_COUNT
+} CullMode;
+
+static const char* s_cullModeNames[CULL_MODE_COUNT] = {"off", "pvs", "portal"};
+
 // Scary character structure
 typedef struct {
     Vector3 position;
@@ -45,20 +106,6 @@ typedef struct {
     float height;
 } ScaryCharacter;
 
-// Helper function: Clamp float value
-static inline float clampf(float v, float lo, float hi) {
-    return (v < lo) ? lo : (v > hi) ? hi : v;
-}
-
-// Circle (player) vs axis-aligned rectangle (wall) collision in XZ plane
-static bool CircleRectIntersect(Vector2 c, float r, Rectangle rect) {
-    float nx = clampf(c.x, rect.x, rect.x + rect.width);
-    float nz = clampf(c.y, rect.y, rect.y + rect.height);
-    float dx = c.x - nx;
-    float dz = c.y - nz;
-    return (dx*dx + dz*dz) <= r*r;
-}
-
 // Circle vs circle collision in XZ plane
 static bool CircleCircleIntersect(Vector2 c1, float r1, Vector2 c2, float r2) {
     float dx = c1.x - c2.x;
@@ -68,14 +115,6 @@ static bool CircleCircleIntersect(Vector2 c1, float r1, Vector2 c2, float r2) {
     return distSq <= radiusSum * radiusSum;
 }
 
-// Check collision with any wall rectangle
-static bool CollidesAny(Vector2 c, float r, const WallRect* walls, int count) {
-    for (int i = 0; i < count; ++i) {
-        if (CircleRectIntersect(c, r, walls[i].rect)) return true;
-    }
-    return false;
-}
-
 // Load best record from file
 static float LoadBestRecord(void) {
     FILE* file = fopen(BEST_RECORD_FILE, "r");
@@ -99,63 +138,213 @@ static void SaveBestRecord(float time) {
     }
 }
 
-// Initialize game
-static void InitGame(Maze** maze, WallRect** walls, int* wallCount, Vector3* playerPos, 
+// Settings for generated levels, from the command line
+static LevelSettings GameLevelSettings(void) {
+    LevelSettings settings = {0};
+    settings.width = s_mazeWidth;
+    settings.height = s_mazeHeight;
+    settings.cellSize = CELL_SIZE;
+    settings.wallHeight = WALL_HEIGHT;
+    settings.wallThick = WALL_THICK;
+    settings.algorithm = s_mazeAlgorithm;
+    settings.generatorThreads = s_generatorThreads;
+    settings.packed = s_packedMaze;
+    settings.maxTorches = MAX_TORCHES;
+    return settings;
+}
+
+// Initialize game. A generated level is taken from `next` (built in the
+// background into the spare arena) when given, otherwise it is built here.
+// Per-level allocations come from the level arena, which is reset first.
+static void InitGame(Maze** maze, WallRect** walls, int* wallCount, MazeMesh** wallMesh, FlowField** flowField,
+                     Pvs** pvs, PortalCuller** portalCuller, VisibleSet** visibleCells,
+                     const GameAssets* assets, Vector3* playerPos,
                      float* yaw, float* pitch, GameState* gameState,
-                     Torch** torches, int* torchCount, ParticleSystem*** particleSystems,
-                     ScaryCharacter* scaryChars, int scaryCharCount, float* gameTimer) {
+                     Torch** torches, int* torchCount, ParticleSystem** particleSystems,
+                     ScaryCharacter* scaryChars, int scaryCharCount, float* gameTimer,
+                     uint64_t levelSeed, Rng* chaserRng, Level* next, Arena** levelArena, Arena** spareArena) {
     // Free old maze if it exists
     if (*maze) {
         Maze_Destroy(*maze);
         *maze = NULL;
     }
-    if (*walls) {
-        free(*walls);
-        *walls = NULL;
+    if (*wallMesh) {
+        MazeMesh_Destroy(*wallMesh);
+        *wallMesh = NULL;
     }
-    if (*torches) {
-        free(*torches);
-        *torches = NULL;
+    if (*flowField) {
+        FlowField_Destroy(*flowField);
+        *flowField = NULL;
+    }
+    if (*pvs) {
+        Pvs_Destroy(*pvs);
+        *pvs = NULL;
+    }
+    if (*portalCuller) {
+        PortalCuller_Destroy(*portalCuller);
+        *portalCuller = NULL;
+    }
+    if (*visibleCells) {
+        VisibleSet_Destroy(*visibleCells);
+        *visibleCells = NULL;
+    }
+    
+    // The walls, torches and particle systems (and a generated maze) all
+    // live in the level arena
+    Arena_Reset(*levelArena);
+    *walls = NULL;
+    *torches = NULL;
+    *particleSystems = NULL;
+    
+    // Open a baked level pack if one was given: the maze, wall mesh, PVS and
+    // torches are used straight from the mapped file
+    LevelPack pack = {0};
+    bool fromPack = false;
+    if (s_levelPackFile) {
+        *maze = LevelPack_Open(s_levelPackFile, &pack);
+        if (*maze) {
+            fromPack = true;
+            s_mazeWidth = (*maze)->width;
+            s_mazeHeight = (*maze)->height;
+            if ((*maze)->seed) levelSeed = (*maze)->seed;
+        } else {
+            TraceLog(LOG_WARNING, "Generating a maze instead of loading %s", s_levelPackFile);
+            s_levelPackFile = NULL;
+        }
     }
-    if (*particleSystems) {
-        for (int i = 0; i < *torchCount; i++) {
-            if ((*particleSystems)[i]) {
-                ParticleSystem_Destroy((*particleSystems)[i]);
+    
+    // Map a saved maze if one was given; its seed drives torches and chasers.
+    // Room for its wall runs (one per lattice edge at most) is taken first,
+    // so a file too large to play is refused before it is installed.
+    size_t maxFileWalls = 0;
+    if (s_mazeFile && !*maze) {
+        Maze* mapped = Maze_Map(s_mazeFile);
+        if (mapped) {
+            maxFileWalls = (size_t)mapped->width * mapped->height * 2 + mapped->width + mapped->height;
+            if (maxFileWalls <= 0x7FFFFFFF) {
+                *walls = (WallRect*)Arena_Alloc(*levelArena, maxFileWalls * sizeof(WallRect));
             }
+            if (!*walls) {
+                TraceLog(LOG_WARNING, "%s is %dx%d, too large to play", s_mazeFile, mapped->width, mapped->height);
+                Maze_Destroy(mapped);
+                mapped = NULL;
+            }
+        }
+        *maze = mapped;
+        if (*maze) {
+            s_mazeWidth = (*maze)->width;
+            s_mazeHeight = (*maze)->height;
+            if ((*maze)->seed) levelSeed = (*maze)->seed;
+        } else {
+            TraceLog(LOG_WARNING, "Generating a maze instead of loading %s", s_mazeFile);
+            s_mazeFile = NULL;
         }
-        free(*particleSystems);
-        *particleSystems = NULL;
     }
     
-    // Create and generate a new maze
-    *maze = Maze_Create(MAZE_WIDTH, MAZE_HEIGHT, CELL_SIZE);
+    // Otherwise the level is generated; if it came from the prefetch thread
+    // only the GPU upload is left to do here
+    Level* level = NULL;
+    if (*maze) {
+        Level_Destroy(next);
+    } else if (next) {
+        // The prefetched level's arena becomes the level arena, and the old
+        // one, now empty, is spare for the next prefetch
+        level = next;
+        *spareArena = *levelArena;
+        *levelArena = next->arena;
+    } else {
+        LevelSettings settings = GameLevelSettings();
+        level = Level_Build(&settings, levelSeed, *levelArena);
+    }
+    if (level) {
+        *maze = level->maze;
+        level->maze = NULL;
+    }
     if (!*maze) {
         TraceLog(LOG_ERROR, "Failed to create maze!");
+        Level_Destroy(level);
         return;
     }
     
-    Maze_Generate(*maze);
-    
-    // Allocate wall rectangles
-    int maxWalls = MAZE_WIDTH * MAZE_HEIGHT * 4;
-    *walls = (WallRect*)malloc(maxWalls * sizeof(WallRect));
-    if (!*walls) {
-        TraceLog(LOG_ERROR, "Failed to allocate wall rectangles!");
-        return;
+    if (fromPack) {
+        // Walls are only needed to bake the mesh and place the torches,
+        // and the pack holds both already, so walls stays NULL with no count
+        *wallMesh = MazeMesh_Upload(&pack.mesh, *maze, pack.wallHeight, pack.wallThick,
+                                    assets->wallTexture, assets->floorTexture, assets->ceilingTexture);
+        if (!*wallMesh) {
+            TraceLog(LOG_ERROR, "Failed to upload wall mesh!");
+        }
+        // The PVS arrays stay in the mapping and the struct in the level
+        // arena, so Pvs_Destroy leaves this one alone
+        if (pack.pvs.width > 0) {
+            *pvs = (Pvs*)Arena_Alloc(*levelArena, sizeof(Pvs));
+            if (*pvs) **pvs = pack.pvs;
+        }
+        *wallCount = 0;
+        *torchCount = 0;
+        if (pack.torchCount > 0) {
+            *torches = (Torch*)Arena_Alloc(*levelArena, pack.torchCount * sizeof(Torch));
+            if (*torches) {
+                memcpy(*torches, pack.torches, pack.torchCount * sizeof(Torch));
+                *torchCount = pack.torchCount;
+            }
+        }
+    } else if (level) {
+        // Take over the generated level
+        *walls = level->walls;
+        *wallCount = level->wallCount;
+        *torches = level->torches;
+        *torchCount = level->torchCount;
+        *flowField = level->flowField;
+        *portalCuller = level->portalCuller;
+        *visibleCells = level->visibleCells;
+        level->flowField = NULL;
+        level->portalCuller = NULL;
+        level->visibleCells = NULL;
+        *wallMesh = MazeMesh_UploadOwned(&level->mesh, *maze, WALL_HEIGHT, WALL_THICK,
+                                         assets->wallTexture, assets->floorTexture, assets->ceilingTexture);
+        if (!*wallMesh) {
+            TraceLog(LOG_ERROR, "Failed to build wall mesh!");
+        }
+        Level_Destroy(level);
+    } else {
+        // Each physical wall once, collinear runs merged, into the room
+        // reserved when the file was mapped
+        *wallCount = Maze_GetMergedWallRects(*maze, *walls, (int)maxFileWalls);
+        Arena_Shrink(*levelArena, *walls, (size_t)*wallCount * sizeof(WallRect));
+        
+        // Bake the chunked wall/floor/ceiling meshes once per maze
+        *wallMesh = MazeMesh_Build(*maze, *walls, *wallCount, WALL_HEIGHT, WALL_THICK,
+                                   assets->wallTexture, assets->floorTexture, assets->ceilingTexture);
+        if (!*wallMesh) {
+            TraceLog(LOG_ERROR, "Failed to build wall mesh!");
+        }
+        
+        // Generate torches (sparse random placement for scary atmosphere)
+        *torches = (Torch*)Arena_Alloc(*levelArena, MAX_TORCHES * sizeof(Torch));
+        Rng torchRng = Rng_ForStream(levelSeed, RNG_STREAM_TORCHES, 0);
+        *torchCount = Torches_Generate(*maze, *walls, *wallCount, *torches, MAX_TORCHES, &torchRng);
     }
     
-    *wallCount = Maze_GetWallRects(*maze, *walls, maxWalls);
+    // Render culling state (the PVS is built the first time it is selected,
+    // unless the level pack carried one)
+    if (!*portalCuller) *portalCuller = PortalCuller_Create(*maze);
+    if (!*visibleCells) *visibleCells = VisibleSet_Create(*maze);
     
-    // Generate torches (sparse random placement for scary atmosphere)
-    int maxTorches = 25;
-    *torchCount = Torches_Generate(*maze, torches, maxTorches);
+    // Shader materials: every chunk shares the one program and its uniforms
+    if (assets->shaderMaterials) {
+        MazeMesh_SetShader(*wallMesh, assets->material.shader);
+        ProcMaterial_SetScale(&assets->material, (*maze)->cellSize, WALL_HEIGHT);
+    }
     
     // Create particle systems for each torch
     if (*torchCount > 0) {
-        *particleSystems = (ParticleSystem**)malloc(*torchCount * sizeof(ParticleSystem*));
+        *particleSystems = (ParticleSystem*)Arena_Alloc(*levelArena, *torchCount * sizeof(ParticleSystem));
         if (*particleSystems) {
             for (int i = 0; i < *torchCount; i++) {
-                (*particleSystems)[i] = ParticleSystem_Create(20);
+                Particle* particles = (Particle*)Arena_Alloc(*levelArena, PARTICLES_PER_TORCH * sizeof(Particle));
+                ParticleSystem_Init(&(*particleSystems)[i], particles, PARTICLES_PER_TORCH,
+                                    Rng_ForStream(levelSeed, RNG_STREAM_PARTICLES, (uint64_t)i));
             }
         }
     }
@@ -166,33 +355,37 @@ static void InitGame(Maze** maze, WallRect** walls, int* wallCount, Vector3* pla
     playerPos->y = 0.0f;
     playerPos->z = startWorld.y;
     
+    // Chasers path towards the player through this field
+    if (!*flowField) {
+        *flowField = FlowField_Create(*maze);
+        FlowField_Build(*flowField, *maze, (int)(*maze)->startPos.x, (int)(*maze)->startPos.y);
+    }
+    
     // Initialize scary characters at random positions
+    *chaserRng = Rng_ForStream(levelSeed, RNG_STREAM_CHASERS, 0);
     if (scaryChars && scaryCharCount > 0) {
         Vector2 playerStartWorld = Maze_CellToWorld(*maze, (int)(*maze)->startPos.x, (int)(*maze)->startPos.y);
         
         const float MIN_DISTANCE_FROM_PLAYER = 30.0f;
         
+        // One bit per cell so duplicate checks stay O(1) with many chasers
+        unsigned char* occupied = (unsigned char*)Arena_Calloc(*levelArena,
+                                                               ((size_t)(*maze)->width * (*maze)->height + 7) / 8, 1);
+        
         for (int i = 0; i < scaryCharCount; i++) {
             int attempts = 0;
             int cellX, cellY;
             bool validPos = false;
             
             while (!validPos && attempts < 200) {
-                cellX = rand() % (*maze)->width;
-                cellY = rand() % (*maze)->height;
+                cellX = (int)Rng_Range(chaserRng, (uint32_t)(*maze)->width);
+                cellY = (int)Rng_Range(chaserRng, (uint32_t)(*maze)->height);
                 
                 bool isStart = (cellX == (int)(*maze)->startPos.x && cellY == (int)(*maze)->startPos.y);
                 bool isExit = (cellX == (int)(*maze)->exitPos.x && cellY == (int)(*maze)->exitPos.y);
                 
-                bool isDuplicate = false;
-                for (int j = 0; j < i; j++) {
-                    int existingCellX, existingCellY;
-                    Maze_WorldToCell(*maze, scaryChars[j].position.x, scaryChars[j].position.z, &existingCellX, &existingCellY);
-                    if (cellX == existingCellX && cellY == existingCellY) {
-                        isDuplicate = true;
-                        break;
-                    }
-                }
+                size_t cellIdx = (size_t)cellY * (*maze)->width + cellX;
+                bool isDuplicate = occupied && (occupied[cellIdx / 8] & (1u << (cellIdx % 8)));
                 
                 Vector2 charWorldPos = Maze_CellToWorld(*maze, cellX, cellY);
                 float dx = charWorldPos.x - playerStartWorld.x;
@@ -209,8 +402,8 @@ static void InitGame(Maze** maze, WallRect** walls, int* wallCount, Vector3* pla
             if (!validPos) {
                 const float RELAXED_DISTANCE = 25.0f;
                 for (int retry = 0; retry < 50; retry++) {
-                    cellX = rand() % (*maze)->width;
-                    cellY = rand() % (*maze)->height;
+                    cellX = (int)Rng_Range(chaserRng, (uint32_t)(*maze)->width);
+                    cellY = (int)Rng_Range(chaserRng, (uint32_t)(*maze)->height);
                     Vector2 charWorldPos = Maze_CellToWorld(*maze, cellX, cellY);
                     float dx = charWorldPos.x - playerStartWorld.x;
                     float dz = charWorldPos.y - playerStartWorld.y;
@@ -221,11 +414,16 @@ static void InitGame(Maze** maze, WallRect** walls, int* wallCount, Vector3* pla
                     }
                 }
                 if (!validPos) {
-                    cellX = rand() % (*maze)->width;
-                    cellY = rand() % (*maze)->height;
+                    cellX = (int)Rng_Range(chaserRng, (uint32_t)(*maze)->width);
+                    cellY = (int)Rng_Range(chaserRng, (uint32_t)(*maze)->height);
                 }
             }
             
+            if (occupied) {
+                size_t cellIdx = (size_t)cellY * (*maze)->width + cellX;
+                occupied[cellIdx / 8] |= (unsigned char)(1u << (cellIdx % 8));
+            }
+            
             Vector2 worldPos = Maze_CellToWorld(*maze, cellX, cellY);
             scaryChars[i].position = (Vector3){worldPos.x, 0.0f, worldPos.y};
             scaryChars[i].speed = SCARY_CHAR_SPEED;
@@ -240,135 +438,47 @@ static void InitGame(Maze** maze, WallRect** walls, int* wallCount, Vector3* pla
     *gameTimer = 0.0f;
 }
 
-// Static cube model
-static Model s_cubeModel = {0};
-static bool s_cubeModelCreated = false;
-
-static Model* GetCubeModel(void) {
-    if (!s_cubeModelCreated) {
-        Mesh cubeMesh = GenMeshCube(1.0f, 1.0f, 1.0f);
-        s_cubeModel = LoadModelFromMesh(cubeMesh);
-        s_cubeModelCreated = true;
-    }
-    return &s_cubeModel;
+// GPU memory of a texture with its mip levels
+static double TextureMegabytes(Texture2D texture) {
+    return (double)TexEncode_DataSize(texture.width, texture.height, texture.format, texture.mipmaps) /
+           (1024.0 * 1024.0);
 }
 
-static void CleanupCubeModel(void) {
-    if (s_cubeModelCreated && s_cubeModel.meshCount > 0) {
-        UnloadModel(s_cubeModel);
-        s_cubeModel.meshCount = 0;
-        s_cubeModelCreated = false;
+// Log where a texture's load time went once it has been swapped in
+static void LogTextureTiming(const GameAssets* assets, int which) {
+    static const char* const textureNames[ASSET_TEXTURE_COUNT] = {"wall", "floor", "ceiling"};
+    const Texture2D textures[ASSET_TEXTURE_COUNT] = {assets->wallTexture, assets->floorTexture, assets->ceilingTexture};
+    const Texture2D texture = textures[which];
+    const AssetLoadTiming* t = &assets->timings[which];
+    const char* format = texture.format == PIXELFORMAT_COMPRESSED_DXT1_RGB ? "DXT1" : "RGBA8";
+    if (t->cacheHit) {
+        TraceLog(LOG_INFO, "Texture %-7s cache hit:  map %.1f ms, upload %.1f ms | %s, %d mips, %.2f MB",
+                 textureNames[which], t->cacheMs, t->uploadMs, format, texture.mipmaps, TextureMegabytes(texture));
+    } else {
+        TraceLog(LOG_INFO,
+                 "Texture %-7s cache %s: generate %.1f ms, encode %.1f ms, store %.1f ms, upload %.1f ms | "
+                 "%s, %d mips, %.2f MB",
+                 textureNames[which], s_textureCacheDir ? "miss" : "off ", t->generateMs, t->encodeMs, t->cacheMs,
+                 t->uploadMs, format, texture.mipmaps, TextureMegabytes(texture));
     }
 }
 
-static Texture2D s_currentCubeTexture = {0};
-static void DrawTexturedCube(Vector3 position, Vector3 size, Texture2D texture) {
-    Model* cubeModel = GetCubeModel();
-    
-    if (s_currentCubeTexture.id != texture.id) {
-        cubeModel->materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texture;
-        s_currentCubeTexture = texture;
-    }
-    
-    DrawModelEx(*cubeModel, position, (Vector3){0, 1, 0}, 0.0f, size, WHITE);
-}
-
-// Static plane model
-static Model s_planeModel = {0};
-static bool s_planeModelCreated = false;
-
-static Model* GetPlaneModel(void) {
-    if (!s_planeModelCreated) {
-        Mesh planeMesh = GenMeshPlane(1.0f, 1.0f, 1, 1);
-        s_planeModel = LoadModelFromMesh(planeMesh);
-        s_planeModelCreated = true;
-    }
-    return &s_planeModel;
-}
-
-static Texture2D s_currentPlaneTexture = {0};
-static void DrawTexturedPlane(Vector3 position, Vector2 size, Texture2D texture) {
-    Model* planeModel = GetPlaneModel();
-    
-    if (s_currentPlaneTexture.id != texture.id) {
-        planeModel->materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texture;
-        s_currentPlaneTexture = texture;
-    }
-    
-    DrawModelEx(*planeModel, position, (Vector3){0, 1, 0}, 0.0f, (Vector3){size.x, 1.0f, size.y}, WHITE);
-}
-
-static void CleanupPlaneModel(void) {
-    if (s_planeModelCreated && s_planeModel.meshCount > 0) {
-        UnloadModel(s_planeModel);
-        s_planeModel.meshCount = 0;
-        s_planeModelCreated = false;
-    }
+// Check whether a world position lies in a visible cell (everything is
+// visible when culling is off)
+static bool IsPointVisible(const Maze* maze, const VisibleSet* visible, Vector3 position) {
+    if (!visible) return true;
+    int cellX, cellY;
+    Maze_WorldToCell(maze, position.x, position.z, &cellX, &cellY);
+    return VisibleSet_Contains(visible, cellX, cellY);
 }
 
 // Render the maze in 3D
-static void RenderMaze(const Maze* maze, const GameAssets* assets) {
+static void RenderMaze(const Maze* maze, MazeMesh* wallMesh, const Frustum* frustum, const VisibleSet* visible,
+                       const GameAssets* assets) {
     if (!maze || !assets || !assets->loaded) return;
     
-    const float halfCell = maze->cellSize * 0.5f;
-    const float wallHalfHeight = WALL_HEIGHT * 0.5f;
-    
-    float mazeWidth = maze->width * maze->cellSize;
-    float mazeHeight = maze->height * maze->cellSize;
-    
-    // Draw the floor
-    DrawTexturedPlane((Vector3){0, 0, 0}, (Vector2){mazeWidth, mazeHeight}, assets->floorTexture);
-    
-    // Draw the ceiling
-    DrawTexturedPlane((Vector3){0, WALL_HEIGHT, 0}, (Vector2){mazeWidth, mazeHeight}, assets->ceilingTexture);
-    
-    // Draw the walls for each cell
-    for (int y = 0; y < maze->height; y++) {
-        for (int x = 0; x < maze->width; x++) {
-            float worldX = (x - maze->width * 0.5f + 0.5f) * maze->cellSize;
-            float worldZ = (y - maze->height * 0.5f + 0.5f) * maze->cellSize;
-            
-            // Draw the north wall
-            if (Maze_HasWall(maze, x, y, MAZE_NORTH)) {
-                DrawTexturedCube((Vector3){
-                    worldX,
-                    wallHalfHeight,
-                    worldZ - halfCell
-                }, (Vector3){maze->cellSize, WALL_HEIGHT, WALL_THICK}, assets->wallTexture);
-            }
-            
-            // Draw the south wall
-            if (Maze_HasWall(maze, x, y, MAZE_SOUTH)) {
-                DrawTexturedCube((Vector3){
-                    worldX,
-                    wallHalfHeight,
-                    worldZ + halfCell
-                }, (Vector3){maze->cellSize, WALL_HEIGHT, WALL_THICK}, assets->wallTexture);
-            }
-            
-            // Draw the west wall
-            if (Maze_HasWall(maze, x, y, MAZE_WEST)) {
-                DrawTexturedCube((Vector3){
-                    worldX - halfCell,
-                    wallHalfHeight,
-                    worldZ
-                }, (Vector3){WALL_THICK, WALL_HEIGHT, maze->cellSize}, assets->wallTexture);
-            }
-            
-            // Draw the east wall
-            if (Maze_HasWall(maze, x, y, MAZE_EAST)) {
-                DrawTexturedCube((Vector3){
-                    worldX + halfCell,
-                    wallHalfHeight,
-                    worldZ
-                }, (Vector3){WALL_THICK, WALL_HEIGHT, maze->cellSize}, assets->wallTexture);
-            }
-        }
-    }
-    
-    // Reset the texture tracking for the next frame
-    s_currentCubeTexture.id = 0;
-    s_currentPlaneTexture.id = 0;
+    // Draw the floor, ceiling and walls of the chunks in view
+    MazeMesh_Draw(wallMesh, frustum, visible);
     
     // Highlight the exit cell (green floor)
     Vector2 exitWorld = Maze_CellToWorld(maze, (int)maze->exitPos.x, (int)maze->exitPos.y);
@@ -377,8 +487,73 @@ static void RenderMaze(const Maze* maze, const GameAssets* assets) {
               (Color){0, 200, 0, 255});
 }
 
-int main(void) {
-    srand((unsigned int)time(NULL));
+int main(int argc, char** argv) {
+    s_masterSeed = (uint64_t)time(NULL);
+    
+    // Parse the command line
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            s_masterSeed = strtoull(argv[++i], NULL, 0);
+            continue;
+        }
+        if (strcmp(argv[i], "--texture-size") == 0 && i + 1 < argc) {
+            int n = atoi(argv[++i]);
+            if (n > 0 && n <= 8192) s_textureSize = n;
+            continue;
+        }
+        if (strcmp(argv[i], "--texture-cache") == 0 && i + 1 < argc) {
+            s_textureCacheDir = argv[++i];
+            continue;
+        }
+        if (strcmp(argv[i], "--compress-textures") == 0) {
+            s_compressTextures = true;
+            continue;
+        }
+        if (strcmp(argv[i], "--shader-materials") == 0) {
+            s_shaderMaterials = true;
+            continue;
+        }
+        if (strcmp(argv[i], "--no-texture-cache") == 0) {
+            s_textureCacheDir = NULL;
+            continue;
+        }
+        if (strcmp(argv[i], "--algo") == 0 && i + 1 < argc) {
+            if (!Maze_AlgorithmFromName(argv[++i], &s_mazeAlgorithm)) {
+                TraceLog(LOG_WARNING, "Unknown maze algorithm '%s', using %s", argv[i],
+                         Maze_AlgorithmName(s_mazeAlgorithm));
+            }
+            continue;
+        }
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            int n = atoi(argv[++i]);
+            s_generatorThreads = n > 0 ? n : Maze_HardwareThreads();
+            continue;
+        }
+        if (strcmp(argv[i], "--packed") == 0) {
+            s_packedMaze = true;
+            continue;
+        }
+        if (strcmp(argv[i], "--maze") == 0 && i + 1 < argc) {
+            s_mazeFile = argv[++i];
+            continue;
+        }
+        if (strcmp(argv[i], "--pack") == 0 && i + 1 < argc) {
+            s_levelPackFile = argv[++i];
+            continue;
+        }
+        if (strcmp(argv[i], "--chasers") == 0 && i + 1 < argc) {
+            int n = atoi(argv[++i]);
+            if (n >= 0) s_chaserCount = n;
+            continue;
+        }
+        if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            int w = 0, h = 0;
+            if (sscanf(argv[++i], "%dx%d", &w, &h) == 2 && w > 0 && h > 0) {
+                s_mazeWidth = w;
+                s_mazeHeight = h;
+            }
+        }
+    }
     
     // Set up the window
     SetConfigFlags(FLAG_WINDOW_RESIZABLE | FLAG_VSYNC_HINT | FLAG_MSAA_4X_HINT);
@@ -386,11 +561,18 @@ int main(void) {
     SetTargetFPS(120);
     
     bool mouseCaptured = true;
+    bool showStats = false;
+    CullMode cullMode = CULL_PORTAL;
     DisableCursor();
     
     Maze* maze = NULL;
     WallRect* walls = NULL;
     int wallCount = 0;
+    MazeMesh* wallMesh = NULL;
+    FlowField* flowField = NULL;
+    Pvs* pvs = NULL;
+    PortalCuller* portalCuller = NULL;
+    VisibleSet* visibleCells = NULL;
     GameState gameState = GAME_STATE_PLAYING;
     
     // Set up the player
@@ -410,33 +592,73 @@ int main(void) {
     cam.fovy = 75.0f;
     cam.projection = CAMERA_PERSPECTIVE;
     
-    // Load the assets
-    GameAssets* assets = Assets_Load();
+    TraceLog(LOG_INFO, "Master seed: %llu (replay with --seed)", (unsigned long long)s_masterSeed);
+    
+    // Load the assets: placeholders now, generated textures as they finish
+    double startupStart = GetTime();
+    bool firstFrameLogged = false;
+    const AssetSettings assetSettings = {s_textureSize, s_compressTextures, s_textureCacheDir, s_shaderMaterials};
+    GameAssets* assets = Assets_Load(s_masterSeed, &assetSettings);
     if (!assets) {
         TraceLog(LOG_ERROR, "Failed to load assets!");
         CloseWindow();
         return 1;
     }
+    if (assets->shaderMaterials) TraceLog(LOG_INFO, "Surfaces use the material shader; no textures generated");
     
     // Set up the torches and particle systems
     Torch* torches = NULL;
     int torchCount = 0;
-    ParticleSystem** particleSystems = NULL;
+    ParticleSystem* particleSystems = NULL;
     
     // Set up the scary characters
-    ScaryCharacter scaryChars[SCARY_CHAR_COUNT] = {0};
+    ScaryCharacter* scaryChars = (ScaryCharacter*)calloc(s_chaserCount > 0 ? s_chaserCount : 1, sizeof(ScaryCharacter));
+    Rng chaserRng = {0};
+    
+    // Levels are numbered so restarts stay reproducible from the master seed
+    uint64_t levelIndex = 0;
     
     // Set up the timer and best record
     float gameTimer = 0.0f;
     float bestRecord = LoadBestRecord();
     
+    // Per-level memory: the current level's arena and a spare one the next
+    // level is built in. They trade places on restart and keep their blocks,
+    // so after the first restart levels of the same size reuse the same memory.
+    Arena* levelArena = Arena_Create(0);
+    Arena* spareArena = Arena_Create(0);
+    if (!levelArena || !spareArena || !scaryChars) {
+        TraceLog(LOG_ERROR, "Failed to allocate level memory!");
+        Arena_Destroy(levelArena);
+        Arena_Destroy(spareArena);
+        free(scaryChars);
+        Assets_Unload(assets);
+        CloseWindow();
+        return 1;
+    }
+    
     // Initialize the game
-    InitGame(&maze, &walls, &wallCount, &playerPos, &yaw, &pitch, &gameState,
-             &torches, &torchCount, &particleSystems, scaryChars, SCARY_CHAR_COUNT, &gameTimer);
+    InitGame(&maze, &walls, &wallCount, &wallMesh, &flowField, &pvs, &portalCuller, &visibleCells, assets, &playerPos, &yaw, &pitch, &gameState,
+             &torches, &torchCount, &particleSystems, scaryChars, s_chaserCount, &gameTimer,
+             Rng_Mix(s_masterSeed, levelIndex++), &chaserRng, NULL, &levelArena, &spareArena);
+    
+    // Build the next level in the background so a restart only uploads it
+    // (a saved maze or level pack is reloaded as is instead)
+    LevelSettings levelSettings = GameLevelSettings();
+    LevelPrefetch* nextLevel = NULL;
+    if (!s_levelPackFile && !s_mazeFile) {
+        nextLevel = LevelPrefetch_Start(&levelSettings, Rng_Mix(s_masterSeed, levelIndex), spareArena);
+    }
+    
+    // Debug builds count the main thread's heap allocations per frame
+    long long frameAllocs = 0;
+    bool allocWarned = false;
     
     // Start the main game loop
     while (!WindowShouldClose()) {
         float dt = GetFrameTime();
+        long long frameAllocStart = HeapCheck_Allocations();
+        bool frameSetup = false;    // Restarts, PVS builds and texture swaps may allocate
         
         // Toggle the mouse capture
         if (IsKeyPressed(KEY_F)) {
@@ -445,10 +667,51 @@ int main(void) {
             else EnableCursor();
         }
         
+        // Toggle the render stats overlay
+        if (IsKeyPressed(KEY_F3)) {
+            showStats = !showStats;
+        }
+        
+        // Cycle visibility culling modes
+        if (IsKeyPressed(KEY_V)) {
+            cullMode = (CullMode)((cullMode + 1) % CULL_MODE_COUNT);
+        }
+        
         // Restart the game
         if (IsKeyPressed(KEY_R)) {
-            InitGame(&maze, &walls, &wallCount, &playerPos, &yaw, &pitch, &gameState,
-                     &torches, &torchCount, &particleSystems, scaryChars, SCARY_CHAR_COUNT, &gameTimer);
+            double restartStart = GetTime();
+            bool prefetched = nextLevel != NULL;
+            bool wasReady = LevelPrefetch_IsReady(nextLevel);
+            Level* next = LevelPrefetch_Finish(nextLevel);
+            nextLevel = NULL;
+            double buildSeconds = next ? next->buildSeconds : 0.0;
+            InitGame(&maze, &walls, &wallCount, &wallMesh, &flowField, &pvs, &portalCuller, &visibleCells, assets, &playerPos, &yaw, &pitch, &gameState,
+                     &torches, &torchCount, &particleSystems, scaryChars, s_chaserCount, &gameTimer,
+                     Rng_Mix(s_masterSeed, levelIndex++), &chaserRng, next, &levelArena, &spareArena);
+            frameSetup = true;
+            allocWarned = false;
+            double restartMs = (GetTime() - restartStart) * 1000.0;
+            if (prefetched) {
+                TraceLog(LOG_INFO, "Restart took %.1f ms (next level %s, built in %.1f ms in the background)",
+                         restartMs, wasReady ? "was ready" : "still building", buildSeconds * 1000.0);
+            } else {
+                TraceLog(LOG_INFO, "Restart took %.1f ms", restartMs);
+            }
+            if (!s_levelPackFile && !s_mazeFile) {
+                nextLevel = LevelPrefetch_Start(&levelSettings, Rng_Mix(s_masterSeed, levelIndex), spareArena);
+            }
+        }
+        
+        // Swap in generated textures as they finish
+        int swappedTexture = Assets_Poll(assets);
+        if (swappedTexture >= 0) {
+            MazeMesh_SetTextures(wallMesh, assets->wallTexture, assets->floorTexture, assets->ceilingTexture);
+            LogTextureTiming(assets, swappedTexture);
+            if (!assets->loader) {
+                TraceLog(LOG_INFO, "All %dx%d textures in %.1f ms after startup", s_textureSize, s_textureSize,
+                         (GetTime() - startupStart) * 1000.0);
+            }
+            frameSetup = true;
         }
         // timer update
         if (gameState == GAME_STATE_PLAYING) {
@@ -461,11 +724,9 @@ int main(void) {
             // Update particle systems
             if (particleSystems) {
                 for (int i = 0; i < torchCount; i++) {
-                    if (particleSystems[i]) {
-                        Vector3 flamePos = torches[i].position;
-                        flamePos.y += 0.25f; // Offset above torch
-                        ParticleSystem_Update(particleSystems[i], flamePos, dt);
-                    }
+                    Vector3 flamePos = torches[i].position;
+                    flamePos.y += 0.25f; // Offset above torch
+                    ParticleSystem_Update(&particleSystems[i], flamePos, dt);
                 }
             }
         }
@@ -519,12 +780,12 @@ int main(void) {
             Vector2 step = (Vector2){wish.x * speed * dt, wish.y * speed * dt};
             
             Vector2 testX = (Vector2){pXZ.x + step.x, pXZ.y};
-            if (!CollidesAny(testX, PLAYER_RADIUS, walls, wallCount)) {
+            if (!Maze_CollidesCircle(maze, testX, PLAYER_RADIUS)) {
                 pXZ.x = testX.x;
             }
 
             Vector2 testZ = (Vector2){pXZ.x, pXZ.y + step.y};
-            if (!CollidesAny(testZ, PLAYER_RADIUS, walls, wallCount)) {
+            if (!Maze_CollidesCircle(maze, testZ, PLAYER_RADIUS)) {
                 pXZ.y = testZ.y;
             }
             
@@ -554,36 +815,35 @@ int main(void) {
             if (gameState == GAME_STATE_PLAYING) {
                 Vector2 playerPos2D = (Vector2){playerPos.x, playerPos.z};
                 
+                // repair the pursuit field when the player changes cell
+                int playerCellX, playerCellY;
+                Maze_WorldToCell(maze, playerPos.x, playerPos.z, &playerCellX, &playerCellY);
+                FlowField_SetTarget(flowField, maze, playerCellX, playerCellY);
+                
                 // update each scary character
-                for (int i = 0; i < SCARY_CHAR_COUNT; i++) {
+                for (int i = 0; i < s_chaserCount; i++) {
                     Vector2 charPos = (Vector2){scaryChars[i].position.x, scaryChars[i].position.z};
                     
-                    // calculate the direction to the player
+                    // head for the next cell on the path, or straight at the player in the same cell
+                    int charCellX, charCellY;
+                    Maze_WorldToCell(maze, charPos.x, charPos.y, &charCellX, &charCellY);
+                    Vector2 goal = playerPos2D;
+                    int step = FlowField_Direction(flowField, charCellX, charCellY);
+                    if (step) {
+                        int nextX = charCellX + (step == MAZE_EAST) - (step == MAZE_WEST);
+                        int nextY = charCellY + (step == MAZE_SOUTH) - (step == MAZE_NORTH);
+                        goal = Maze_CellToWorld(maze, nextX, nextY);
+                    }
+                    
                     Vector2 dir = (Vector2){
-                        playerPos2D.x - charPos.x,
-                        playerPos2D.y - charPos.y
+                        goal.x - charPos.x,
+                        goal.y - charPos.y
                     };
                     
                     float dist = sqrtf(dir.x * dir.x + dir.y * dir.y);
                     if (dist > 0.001f) {
                         dir.x /= dist;
                         dir.y /= dist;
-                        
-                        float randomAngle = ((float)rand() / (float)RAND_MAX) * 2.0f * 3.14159265359f * SCARY_CHAR_RANDOMNESS;
-                        float cosAngle = cosf(randomAngle);
-                        float sinAngle = sinf(randomAngle);
-                        Vector2 randomDir = (Vector2){
-                            dir.x * cosAngle - dir.y * sinAngle,
-                            dir.x * sinAngle + dir.y * cosAngle
-                        };
-                        dir.x = dir.x * (1.0f - SCARY_CHAR_RANDOMNESS) + randomDir.x * SCARY_CHAR_RANDOMNESS;
-                        dir.y = dir.y * (1.0f - SCARY_CHAR_RANDOMNESS) + randomDir.y * SCARY_CHAR_RANDOMNESS;
-
-                        float dirLen = sqrtf(dir.x * dir.x + dir.y * dir.y);
-                        if (dirLen > 0.001f) {
-                            dir.x /= dirLen;
-                            dir.y /= dirLen;
-                        }
 
                         Vector2 moveStep = (Vector2){
                             dir.x * scaryChars[i].speed * dt,
@@ -591,12 +851,12 @@ int main(void) {
                         };
                         
                         Vector2 testX = (Vector2){charPos.x + moveStep.x, charPos.y};
-                        if (!CollidesAny(testX, scaryChars[i].radius, walls, wallCount)) {
+                        if (!Maze_CollidesCircle(maze, testX, scaryChars[i].radius)) {
                             charPos.x = testX.x;
                         }
                         
                         Vector2 testZ = (Vector2){charPos.x, charPos.y + moveStep.y};
-                        if (!CollidesAny(testZ, scaryChars[i].radius, walls, wallCount)) {
+                        if (!Maze_CollidesCircle(maze, testZ, scaryChars[i].radius)) {
                             charPos.y = testZ.y;
                         }
                         
@@ -615,6 +875,7 @@ int main(void) {
             // check if the player reached the exit
             int cellX, cellY;
             Maze_WorldToCell(maze, playerPos.x, playerPos.z, &cellX, &cellY);
+            
             if (Maze_IsExit(maze, cellX, cellY)) {
                 gameState = GAME_STATE_WON;
                 // update the best record if this is better
@@ -637,17 +898,44 @@ int main(void) {
         BeginDrawing();
         ClearBackground((Color){5, 5, 8, 255});
         
+        // gather the cells visible from the camera cell
+        const VisibleSet* visible = NULL;
+        if (cullMode == CULL_PVS && !pvs && maze) {
+            pvs = Pvs_Build(maze);
+            frameSetup = true;
+            if (pvs) {
+                TraceLog(LOG_INFO, "PVS: %dx%d cells, average %.1f visible per cell, %.1f KB, built in %.1f ms",
+                         maze->width, maze->height, Pvs_AverageSize(pvs),
+                         (double)pvs->bitCount / 8192.0, pvs->buildSeconds * 1000.0);
+            }
+        }
+        if (cullMode == CULL_PVS && pvs && visibleCells) {
+            int camCellX, camCellY;
+            Maze_WorldToCell(maze, cam.position.x, cam.position.z, &camCellX, &camCellY);
+            Pvs_Gather(pvs, camCellX, camCellY, visibleCells);
+            visible = visibleCells;
+        } else if (cullMode == CULL_PORTAL && portalCuller && visibleCells) {
+            float aspect = (float)GetScreenWidth() / (float)GetScreenHeight();
+            Vector3 viewDir = {cam.target.x - cam.position.x, cam.target.y - cam.position.y,
+                               cam.target.z - cam.position.z};
+            if (PortalCuller_Gather(portalCuller, cam.position, viewDir, cam.fovy, aspect, visibleCells)) {
+                visible = visibleCells;
+            }
+        }
+        
         BeginMode3D(cam);
 
         // render the maze with textures
         if (maze) {
-            RenderMaze(maze, assets);
+            Frustum frustum = Frustum_FromCamera(cam, (float)GetScreenWidth() / (float)GetScreenHeight());
+            RenderMaze(maze, wallMesh, &frustum, visible, assets);
         }
         
         if (torches && torchCount > 0) {
-            Torches_Render(torches, torchCount);
-            
             for (int i = 0; i < torchCount; i++) {
+                if (!IsPointVisible(maze, visible, torches[i].position)) continue;
+                Torches_Render(&torches[i], 1);
+                
                 float flicker = 0.5f + 0.4f * sinf(torches[i].flickerTime) + 
                                 0.15f * sinf(torches[i].flickerTime * 3.5f) +
                                 0.1f * sinf(torches[i].flickerTime * 7.0f);
@@ -673,8 +961,8 @@ int main(void) {
             // render the particle systems (flames)
             if (particleSystems) {
                 for (int i = 0; i < torchCount; i++) {
-                    if (particleSystems[i]) {
-                        ParticleSystem_Render(particleSystems[i]);
+                    if (IsPointVisible(maze, visible, torches[i].position)) {
+                        ParticleSystem_Render(&particleSystems[i]);
                     }
                 }
             }
@@ -682,7 +970,9 @@ int main(void) {
         
         // render the scary characters (dark, menacing figures)
         if (gameState == GAME_STATE_PLAYING || gameState == GAME_STATE_GAMEOVER) {
-            for (int i = 0; i < SCARY_CHAR_COUNT; i++) {
+            for (int i = 0; i < s_chaserCount; i++) {
+                if (!IsPointVisible(maze, visible, scaryChars[i].position)) continue;
+                
                 Vector3 charRenderPos = scaryChars[i].position;
                 charRenderPos.y = scaryChars[i].height * 0.5f;
                 
@@ -791,27 +1081,71 @@ int main(void) {
             DrawText(restartText, (screenWidth - textWidth) / 2, screenHeight / 2 + 40, fontSize, RAYWHITE);
         }
         
+        // draw the render stats
+        if (showStats && wallMesh) {
+            char statsText[192];
+            snprintf(statsText, sizeof(statsText),
+                     "FPS: %d (%.2f ms) | Wall pieces: %d | Faces: %d/%d | Chunks: %d/%d | Draw calls: %d",
+                     GetFPS(), dt * 1000.0f, wallMesh->wallCount, wallMesh->drawnFaces, wallMesh->faceCount,
+                     wallMesh->drawnChunks, wallMesh->chunkCount, wallMesh->drawCalls);
+            DrawText(statsText, 20, GetScreenHeight() - 55, 18, RAYWHITE);
+            
+            if (assets->shaderMaterials) {
+                snprintf(statsText, sizeof(statsText), "Textures: none, surfaces evaluated in the material shader");
+            } else {
+                snprintf(statsText, sizeof(statsText), "Textures: %s %dx%d, %.2f MB with mips%s",
+                         assets->wallTexture.format == PIXELFORMAT_COMPRESSED_DXT1_RGB ? "DXT1" : "RGBA8",
+                         assets->wallTexture.width, assets->wallTexture.height,
+                         TextureMegabytes(assets->wallTexture) + TextureMegabytes(assets->floorTexture) +
+                         TextureMegabytes(assets->ceilingTexture),
+                         assets->loader ? " (loading)" : "");
+            }
+            DrawText(statsText, 20, GetScreenHeight() - 80, 18, RAYWHITE);
+            
+            int cellCount = maze->width * maze->height;
+            int visited = cullMode == CULL_PORTAL && portalCuller ? portalCuller->visited : cellCount;
+            int length = snprintf(statsText, sizeof(statsText),
+                                  "Culling [V]: %s | Cells visited: %d | Cells drawn: %d | PVS avg: %.1f",
+                                  s_cullModeNames[cullMode], cullMode == CULL_PVS && visible ? visible->count : visited,
+                                  visible ? visible->count : cellCount, Pvs_AverageSize(pvs));
+            if (frameAllocStart >= 0 && length > 0 && length < (int)sizeof(statsText)) {
+                snprintf(statsText + length, sizeof(statsText) - length, " | Heap allocs: %lld", frameAllocs);
+            }
+            DrawText(statsText, 20, GetScreenHeight() - 30, 18, RAYWHITE);
+        }
+        
+        // Once a level is running its frames should not touch the heap. The
+        // buffer swap in EndDrawing belongs to the driver and is left out.
+        if (frameAllocStart >= 0) {
+            frameAllocs = HeapCheck_Allocations() - frameAllocStart;
+            if (frameAllocs > 0 && !frameSetup && !allocWarned) {
+                TraceLog(LOG_WARNING, "A frame made %lld heap allocations while playing", frameAllocs);
+                allocWarned = true;
+            }
+        }
+        
         EndDrawing();
+        
+        if (!firstFrameLogged) {
+            TraceLog(LOG_INFO, "First frame %.1f ms after startup (%s)", (GetTime() - startupStart) * 1000.0,
+                     assets->loader ? "placeholder textures" : "textures ready");
+            firstFrameLogged = true;
+        }
     }
     
     // Cleanup
+    Level_Destroy(LevelPrefetch_Finish(nextLevel));
     if (maze) Maze_Destroy(maze);
-    if (walls) free(walls);
-    if (torches) free(torches);
-    if (particleSystems) {
-        for (int i = 0; i < torchCount; i++) {
-            if (particleSystems[i]) {
-                ParticleSystem_Destroy(particleSystems[i]);
-            }
-        }
-        free(particleSystems);
-    }
+    if (wallMesh) MazeMesh_Destroy(wallMesh);
+    if (flowField) FlowField_Destroy(flowField);
+    if (pvs) Pvs_Destroy(pvs);
+    if (portalCuller) PortalCuller_Destroy(portalCuller);
+    if (visibleCells) VisibleSet_Destroy(visibleCells);
+    free(scaryChars);
+    Arena_Destroy(levelArena);
+    Arena_Destroy(spareArena);
     if (assets) Assets_Unload(assets);
     
-    // Cleanup static models
-    CleanupCubeModel();
-    CleanupPlaneModel();
-    
     CloseWindow();
     return 0;
 }
@@ -1,160 +1,265 @@
 #include "../include/maze.h"
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include <time.h>
 
-// Helper: Get cell index from coordinates
-static int CellIndex(const Maze* maze, int x, int y) {
-    if (x < 0 || x >= maze->width || y < 0 || y >= maze->height) return -1;
-    return y * maze->width + x;
-}
-
-// Helper: Check if cell is valid and unvisited
-static bool IsValidUnvisited(const Maze* maze, int x, int y, bool* visited) {
-    int idx = CellIndex(maze, x, y);
-    if (idx < 0) return false;
-    return !visited[idx];
-}
-
-// Helper: Get random neighbor for DFS
-static int GetRandomNeighbor(const Maze* maze, int x, int y, bool* visited, int* outDir) {
-    int dirs[4] = {MAZE_NORTH, MAZE_EAST, MAZE_SOUTH, MAZE_WEST};
-    int dx[4] = {0, 1, 0, -1};
-    int dy[4] = {-1, 0, 1, 0};
-    
-    // Shuffle directions for randomness
-    for (int i = 3; i > 0; i--) {
-        int j = rand() % (i + 1);
-        int temp = dirs[i];
-        dirs[i] = dirs[j];
-        dirs[j] = temp;
-        temp = dx[i];
-        dx[i] = dx[j];
-        dx[j] = temp;
-        temp = dy[i];
-        dy[i] = dy[j];
-        dy[j] = temp;
-    }
-    
-    for (int i = 0; i < 4; i++) {
-        int nx = x + dx[i];
-        int ny = y + dy[i];
-        if (IsValidUnvisited(maze, nx, ny, visited)) {
-            *outDir = dirs[i];
-            return 1;
-        }
+#define COLLISION_WALL_THICK 0.1f // Wall thickness for collision
+
+// Helper: Bytes per row of packed storage (rows start on a byte boundary)
+static size_t PackedStride(const Maze* maze) {
+    return MAZE_PACKED_STRIDE(maze->width);
+}
+
+// Bytes of the cells or edges array (tiled layouts pad to whole tiles, 0
+// for source-backed mazes)
+size_t Maze_StorageSize(const Maze* maze) {
+    if (!maze || (!maze->cells && !maze->edges && maze->source.getCell)) return 0;
+    switch (maze->storage) {
+        case MAZE_STORAGE_PACKED:
+            return PackedStride(maze) * maze->height;
+        case MAZE_STORAGE_TILED:
+            return (((size_t)maze->width + 7) >> 3) * (((size_t)maze->height + 7) >> 3) * 64;
+        case MAZE_STORAGE_MORTON:
+            return (((size_t)maze->width + 63) >> 6) * (((size_t)maze->height + 63) >> 6) * 4096;
+        default:
+            return (size_t)maze->width * maze->height;
     }
-    return 0;
+}
+
+// Helper: MAZE_PACKED_* bits of an in-bounds cell
+static unsigned int PackedEdges(const Maze* maze, int x, int y) {
+    return (maze->edges[(size_t)y * PackedStride(maze) + (x >> 2)] >> ((x & 3) * 2)) & 3u;
+}
+
+// Helper: Clear MAZE_PACKED_* bits of an in-bounds cell
+static void PackedOpen(Maze* maze, int x, int y, unsigned int bits) {
+    maze->edges[(size_t)y * PackedStride(maze) + (x >> 2)] &= (unsigned char)~(bits << ((x & 3) * 2));
 }
 
 // Create a new maze structure
 Maze* Maze_Create(int width, int height, float cellSize) {
+    return Maze_CreateEx(width, height, cellSize, MAZE_STORAGE_BYTES);
+}
+
+// Create a new maze with the given cell storage layout
+Maze* Maze_CreateEx(int width, int height, float cellSize, MazeStorage storage) {
     if (width < 1 || height < 1 || cellSize <= 0.0f) return NULL;
     
-    Maze* maze = (Maze*)malloc(sizeof(Maze));
+    Maze* maze = (Maze*)calloc(1, sizeof(Maze));
     if (!maze) return NULL;
     
     maze->width = width;
     maze->height = height;
     maze->cellSize = cellSize;
-    maze->cells = (unsigned char*)calloc(width * height, sizeof(unsigned char));
+    maze->storage = storage;
+    if (storage == MAZE_STORAGE_PACKED) {
+        maze->edges = (unsigned char*)malloc(Maze_StorageSize(maze));
+    } else {
+        maze->cells = (unsigned char*)malloc(Maze_StorageSize(maze));
+    }
     
-    if (!maze->cells) {
+    if (!maze->cells && !maze->edges) {
         free(maze);
         return NULL;
     }
     
     // Initialize all cells with all walls
-    for (int i = 0; i < width * height; i++) {
-        maze->cells[i] = MAZE_ALL;
-    }
+    Maze_Reset(maze);
+    
+    maze->startPos = (Vector2){0, 0};
+    maze->exitPos = (Vector2){width - 1, height - 1};
+    
+    return maze;
+}
+
+// Create a maze whose struct and cell storage come from an arena, so it
+// goes away with the arena's next reset (Maze_Destroy leaves it alone)
+Maze* Maze_CreateIn(Arena* arena, int width, int height, float cellSize, MazeStorage storage) {
+    if (!arena || width < 1 || height < 1 || cellSize <= 0.0f) return NULL;
+    
+    Maze* maze = (Maze*)Arena_Calloc(arena, 1, sizeof(Maze));
+    if (!maze) return NULL;
+    
+    maze->width = width;
+    maze->height = height;
+    maze->cellSize = cellSize;
+    maze->storage = storage;
+    maze->borrowed = true;
+    unsigned char* storageBytes = (unsigned char*)Arena_Alloc(arena, Maze_StorageSize(maze));
+    if (!storageBytes) return NULL;
+    if (storage == MAZE_STORAGE_PACKED) maze->edges = storageBytes;
+    else maze->cells = storageBytes;
     
+    Maze_Reset(maze);
     maze->startPos = (Vector2){0, 0};
     maze->exitPos = (Vector2){width - 1, height - 1};
     
     return maze;
 }
 
-// Destroy maze and free memory
+// Create a maze whose walls come from a storage backend instead of a cells
+// array. The maze takes ownership of the source.
+Maze* Maze_CreateWithSource(int width, int height, float cellSize, MazeSource source) {
+    if (width < 1 || height < 1 || cellSize <= 0.0f || !source.getCell) return NULL;
+    
+    Maze* maze = (Maze*)calloc(1, sizeof(Maze));
+    if (!maze) return NULL;
+    
+    maze->width = width;
+    maze->height = height;
+    maze->cellSize = cellSize;
+    maze->source = source;
+    maze->startPos = (Vector2){0, 0};
+    maze->exitPos = (Vector2){width - 1, height - 1};
+    
+    return maze;
+}
+
+// Destroy maze and free memory (an arena maze is left to its arena)
 void Maze_Destroy(Maze* maze) {
-    if (maze) {
+    if (maze && maze->mapping) {
+        Maze_Unmap(maze);
+    } else if (maze && !maze->borrowed) {
+        if (maze->source.destroy) maze->source.destroy(maze->source.user);
         free(maze->cells);
+        free(maze->edges);
         free(maze);
     }
 }
 
-// Generate maze using DFS backtracking algorithm
-void Maze_Generate(Maze* maze) {
-    if (!maze || !maze->cells) return;
+// Close every wall (source-backed mazes are left alone)
+void Maze_Reset(Maze* maze) {
+    if (!maze) return;
+    if (maze->cells) memset(maze->cells, MAZE_ALL, Maze_StorageSize(maze));
+    if (maze->edges) memset(maze->edges, 0xFF, Maze_StorageSize(maze));
+}
+
+// Store the MAZE_* flags of count cells starting at (x0, y), whatever the
+// layout. Packed mazes keep only the NORTH and WEST bits, so the flags must
+// agree with the neighbours' (as any generated maze does). Runs starting on
+// a multiple of 4 touch no bytes outside their own cells.
+void Maze_SetRow(Maze* maze, int y, int x0, int count, const unsigned char* flags) {
+    if (!maze || y < 0 || y >= maze->height || x0 < 0 || count > maze->width - x0) return;
     
-    // Initialize visited array
-    bool* visited = (bool*)calloc(maze->width * maze->height, sizeof(bool));
-    if (!visited) return;
+    if (maze->cells && maze->storage == MAZE_STORAGE_BYTES) {
+        memcpy(&maze->cells[(size_t)y * maze->width + x0], flags, (size_t)count);
+    } else if (maze->cells) {
+        for (int i = 0; i < count; i++) maze->cells[Maze_CellOffset(maze, x0 + i, y)] = flags[i];
+    } else if (maze->edges) {
+        unsigned char* row = &maze->edges[(size_t)y * PackedStride(maze)];
+        for (int i = 0; i < count; i++) {
+            int x = x0 + i;
+            unsigned int bits = ((flags[i] & MAZE_NORTH) ? MAZE_PACKED_NORTH : 0) | ((flags[i] & MAZE_WEST) ? MAZE_PACKED_WEST : 0);
+            int shift = (x & 3) * 2;
+            row[x >> 2] = (unsigned char)((row[x >> 2] & ~(3u << shift)) | bits << shift);
+        }
+    }
+}
+
+// Open the wall between a cell and its neighbour in one direction. Returns
+// false for border walls and source-backed mazes.
+bool Maze_RemoveWall(Maze* maze, int x, int y, int direction) {
+    if (!maze || x < 0 || x >= maze->width || y < 0 || y >= maze->height) return false;
     
-    // Stack for backtracking
-    typedef struct { int x, y; } StackCell;
-    StackCell* stack = (StackCell*)malloc(maze->width * maze->height * sizeof(StackCell));
-    if (!stack) {
-        free(visited);
-        return;
+    int nx = x, ny = y, opposite;
+    switch (direction) {
+        case MAZE_NORTH: ny--; opposite = MAZE_SOUTH; break;
+        case MAZE_EAST: nx++; opposite = MAZE_WEST; break;
+        case MAZE_SOUTH: ny++; opposite = MAZE_NORTH; break;
+        case MAZE_WEST: nx--; opposite = MAZE_EAST; break;
+        default: return false;
     }
+    if (nx < 0 || nx >= maze->width || ny < 0 || ny >= maze->height) return false;
     
-    int stackTop = 0;
-    
-    // Start from (0, 0)
-    int startX = 0, startY = 0;
-    visited[CellIndex(maze, startX, startY)] = true;
-    stack[stackTop++] = (StackCell){startX, startY};
-    
-    // Direction mappings
-    int oppositeDir[4] = {MAZE_SOUTH, MAZE_WEST, MAZE_NORTH, MAZE_EAST};
-    int dirs[4] = {MAZE_NORTH, MAZE_EAST, MAZE_SOUTH, MAZE_WEST};
-    int dx[4] = {0, 1, 0, -1};
-    int dy[4] = {-1, 0, 1, 0};
-    
-    // DFS backtracking
-    while (stackTop > 0) {
-        int x = stack[stackTop - 1].x;
-        int y = stack[stackTop - 1].y;
-        
-        int dir;
-        if (GetRandomNeighbor(maze, x, y, visited, &dir)) {
-            // Find direction index
-            int dirIdx = 0;
-            for (int i = 0; i < 4; i++) {
-                if (dirs[i] == dir) {
-                    dirIdx = i;
-                    break;
-                }
-            }
-            
-            int nx = x + dx[dirIdx];
-            int ny = y + dy[dirIdx];
-            
-            // Remove walls between current and neighbor
-            int currIdx = CellIndex(maze, x, y);
-            int nextIdx = CellIndex(maze, nx, ny);
-            
-            maze->cells[currIdx] &= ~dir;
-            maze->cells[nextIdx] &= ~oppositeDir[dirIdx];
-            
-            visited[nextIdx] = true;
-            stack[stackTop++] = (StackCell){nx, ny};
-        } else {
-            // Backtrack
-            stackTop--;
-        }
+    if (maze->cells) {
+        maze->cells[Maze_CellOffset(maze, x, y)] &= (unsigned char)~direction;
+        maze->cells[Maze_CellOffset(maze, nx, ny)] &= (unsigned char)~opposite;
+        return true;
     }
+    if (!maze->edges) return false;
     
-    free(stack);
-    free(visited);
+    // The edge belongs to whichever cell has it on its north/west side
+    if (direction == MAZE_NORTH || direction == MAZE_WEST) {
+        PackedOpen(maze, x, y, direction == MAZE_NORTH ? MAZE_PACKED_NORTH : MAZE_PACKED_WEST);
+    } else {
+        PackedOpen(maze, nx, ny, direction == MAZE_SOUTH ? MAZE_PACKED_NORTH : MAZE_PACKED_WEST);
+    }
+    return true;
+}
+
+// Generate a maze with the iterative DFS backtracker
+void Maze_Generate(Maze* maze, Rng* rng) {
+    Maze_GenerateWith(maze, MAZE_ALGO_BACKTRACKER, rng);
+}
+
+// Wall flags of a cell (MAZE_ALL outside the maze)
+unsigned char Maze_GetCell(const Maze* maze, int x, int y) {
+    if (x < 0 || x >= maze->width || y < 0 || y >= maze->height) return MAZE_ALL;
+    if (maze->cells) return maze->cells[Maze_CellOffset(maze, x, y)];
+    if (!maze->edges) return maze->source.getCell(maze->source.user, x, y);
+    
+    // Packed: own north/west edges, east/south from the neighbours
+    unsigned int own = PackedEdges(maze, x, y);
+    unsigned char cell = 0;
+    if (own & MAZE_PACKED_NORTH) cell |= MAZE_NORTH;
+    if (own & MAZE_PACKED_WEST) cell |= MAZE_WEST;
+    if (x + 1 == maze->width || (PackedEdges(maze, x + 1, y) & MAZE_PACKED_WEST)) cell |= MAZE_EAST;
+    if (y + 1 == maze->height || (PackedEdges(maze, x, y + 1) & MAZE_PACKED_NORTH)) cell |= MAZE_SOUTH;
+    return cell;
 }
 
 // Check if a cell has a wall in the given direction
 bool Maze_HasWall(const Maze* maze, int x, int y, int direction) {
-    int idx = CellIndex(maze, x, y);
-    if (idx < 0) return true; // Out of bounds = wall
-    return (maze->cells[idx] & direction) != 0;
+    // Packed mazes answer a single edge with one lookup
+    if (maze->edges && x >= 0 && x < maze->width && y >= 0 && y < maze->height) {
+        switch (direction) {
+            case MAZE_NORTH: return (PackedEdges(maze, x, y) & MAZE_PACKED_NORTH) != 0;
+            case MAZE_WEST: return (PackedEdges(maze, x, y) & MAZE_PACKED_WEST) != 0;
+            case MAZE_EAST: return x + 1 == maze->width || (PackedEdges(maze, x + 1, y) & MAZE_PACKED_WEST);
+            case MAZE_SOUTH: return y + 1 == maze->height || (PackedEdges(maze, x, y + 1) & MAZE_PACKED_NORTH);
+            default: break;
+        }
+    }
+    if (!maze->cells && !maze->edges && maze->source.hasWall &&
+        x >= 0 && x < maze->width && y >= 0 && y < maze->height) {
+        return maze->source.hasWall(maze->source.user, x, y, direction);
+    }
+    return (Maze_GetCell(maze, x, y) & direction) != 0; // Out of bounds = wall
+}
+
+// Helper: Collision rectangle of one cell wall, as listed by Maze_GetWallRects
+static Rectangle EdgeRect(const Maze* maze, int x, int y, int direction) {
+    // Calculate cell center (matching RenderMaze coordinates)
+    float cellCenterX = (x - maze->width * 0.5f + 0.5f) * maze->cellSize;
+    float cellCenterZ = (y - maze->height * 0.5f + 0.5f) * maze->cellSize;
+    float halfCell = maze->cellSize * 0.5f;
+    const float wallThick = COLLISION_WALL_THICK;
+    
+    switch (direction) {
+        case MAZE_NORTH:
+            return (Rectangle){cellCenterX - halfCell - wallThick * 0.5f, cellCenterZ - halfCell - wallThick * 0.5f,
+                               maze->cellSize + wallThick, wallThick};
+        case MAZE_WEST:
+            return (Rectangle){cellCenterX - halfCell - wallThick * 0.5f, cellCenterZ - halfCell - wallThick * 0.5f,
+                               wallThick, maze->cellSize + wallThick};
+        case MAZE_EAST:
+            return (Rectangle){cellCenterX + halfCell - wallThick * 0.5f, cellCenterZ - halfCell - wallThick * 0.5f,
+                               wallThick, maze->cellSize + wallThick};
+        default: // MAZE_SOUTH
+            return (Rectangle){cellCenterX - halfCell - wallThick * 0.5f, cellCenterZ + halfCell - wallThick * 0.5f,
+                               maze->cellSize + wallThick, wallThick};
+    }
+}
+
+// Helper: Append one cell wall to a WallRect list
+static void PushEdgeRect(const Maze* maze, int x, int y, int direction, WallRect* out) {
+    out->rect = EdgeRect(maze, x, y, direction);
+    out->isVertical = (direction == MAZE_WEST || direction == MAZE_EAST);
+    out->x = x + (direction == MAZE_EAST ? 1 : 0);
+    out->y = y + (direction == MAZE_SOUTH ? 1 : 0);
+    out->length = 1;
+    out->caps = WALL_CAP_START | WALL_CAP_END;
 }
 
 // Get all wall rectangles for collision detection
@@ -162,69 +267,181 @@ int Maze_GetWallRects(const Maze* maze, WallRect* outRects, int maxRects) {
     if (!maze || !outRects || maxRects <= 0) return 0;
     
     int count = 0;
-    const float wallThick = 0.1f; // Wall thickness for collision
     
     // Check each cell
     for (int y = 0; y < maze->height && count < maxRects; y++) {
         for (int x = 0; x < maze->width && count < maxRects; x++) {
-            // Calculate cell center (matching RenderMaze coordinates)
-            float cellCenterX = (x - maze->width * 0.5f + 0.5f) * maze->cellSize;
-            float cellCenterZ = (y - maze->height * 0.5f + 0.5f) * maze->cellSize;
-            float halfCell = maze->cellSize * 0.5f;
-            
             // North wall (at north edge of cell)
             if (Maze_HasWall(maze, x, y, MAZE_NORTH)) {
-                outRects[count].rect = (Rectangle){
-                    cellCenterX - halfCell - wallThick * 0.5f,
-                    cellCenterZ - halfCell - wallThick * 0.5f,
-                    maze->cellSize + wallThick,
-                    wallThick
-                };
-                outRects[count].isVertical = false;
-                count++;
+                PushEdgeRect(maze, x, y, MAZE_NORTH, &outRects[count++]);
             }
             
             // West wall (at west edge of cell)
-            if (Maze_HasWall(maze, x, y, MAZE_WEST)) {
-                outRects[count].rect = (Rectangle){
-                    cellCenterX - halfCell - wallThick * 0.5f,
-                    cellCenterZ - halfCell - wallThick * 0.5f,
-                    wallThick,
-                    maze->cellSize + wallThick
-                };
-                outRects[count].isVertical = true;
-                count++;
+            if (count < maxRects && Maze_HasWall(maze, x, y, MAZE_WEST)) {
+                PushEdgeRect(maze, x, y, MAZE_WEST, &outRects[count++]);
             }
             
             // East wall (only for rightmost cells, at east edge)
-            if (x == maze->width - 1 && Maze_HasWall(maze, x, y, MAZE_EAST)) {
-                outRects[count].rect = (Rectangle){
-                    cellCenterX + halfCell - wallThick * 0.5f,
-                    cellCenterZ - halfCell - wallThick * 0.5f,
-                    wallThick,
-                    maze->cellSize + wallThick
-                };
-                outRects[count].isVertical = true;
-                count++;
+            if (count < maxRects && x == maze->width - 1 && Maze_HasWall(maze, x, y, MAZE_EAST)) {
+                PushEdgeRect(maze, x, y, MAZE_EAST, &outRects[count++]);
             }
             
             // South wall (only for bottommost cells, at south edge)
-            if (y == maze->height - 1 && Maze_HasWall(maze, x, y, MAZE_SOUTH)) {
-                outRects[count].rect = (Rectangle){
-                    cellCenterX - halfCell - wallThick * 0.5f,
-                    cellCenterZ + halfCell - wallThick * 0.5f,
-                    maze->cellSize + wallThick,
-                    wallThick
-                };
-                outRects[count].isVertical = false;
-                count++;
+            if (count < maxRects && y == maze->height - 1 && Maze_HasWall(maze, x, y, MAZE_SOUTH)) {
+                PushEdgeRect(maze, x, y, MAZE_SOUTH, &outRects[count++]);
+            }
+        }
+    }
+    
+    return count;
+}
+
+// Helper: Wall on the horizontal lattice edge from corner (x, y) to (x + 1, y)
+static bool HasHorizontalEdge(const Maze* maze, int x, int y) {
+    if (x < 0 || x >= maze->width || y < 0 || y > maze->height) return false;
+    if (y == maze->height) return Maze_HasWall(maze, x, y - 1, MAZE_SOUTH);
+    return Maze_HasWall(maze, x, y, MAZE_NORTH);
+}
+
+// Helper: Wall on the vertical lattice edge from corner (x, y) to (x, y + 1)
+static bool HasVerticalEdge(const Maze* maze, int x, int y) {
+    if (x < 0 || x > maze->width || y < 0 || y >= maze->height) return false;
+    if (x == maze->width) return Maze_HasWall(maze, x - 1, y, MAZE_EAST);
+    return Maze_HasWall(maze, x, y, MAZE_WEST);
+}
+
+// Get each physical wall once, with collinear neighbours merged into runs.
+// End caps are flagged only where no perpendicular wall meets the run.
+int Maze_GetMergedWallRects(const Maze* maze, WallRect* outRects, int maxRects) {
+    if (!maze || !outRects || maxRects <= 0) return 0;
+    
+    int count = 0;
+    const float wallThick = COLLISION_WALL_THICK;
+    const float originX = -maze->width * 0.5f * maze->cellSize;
+    const float originZ = -maze->height * 0.5f * maze->cellSize;
+    
+    // Runs along X on each horizontal lattice line
+    for (int y = 0; y <= maze->height && count < maxRects; y++) {
+        int x = 0;
+        while (x < maze->width && count < maxRects) {
+            if (!HasHorizontalEdge(maze, x, y)) {
+                x++;
+                continue;
             }
+            int start = x;
+            while (x < maze->width && HasHorizontalEdge(maze, x, y)) x++;
+            
+            WallRect* w = &outRects[count++];
+            w->rect = (Rectangle){
+                originX + start * maze->cellSize - wallThick * 0.5f,
+                originZ + y * maze->cellSize - wallThick * 0.5f,
+                (x - start) * maze->cellSize + wallThick,
+                wallThick
+            };
+            w->isVertical = false;
+            w->x = start;
+            w->y = y;
+            w->length = x - start;
+            w->caps = 0;
+            if (!HasVerticalEdge(maze, start, y - 1) && !HasVerticalEdge(maze, start, y)) w->caps |= WALL_CAP_START;
+            if (!HasVerticalEdge(maze, x, y - 1) && !HasVerticalEdge(maze, x, y)) w->caps |= WALL_CAP_END;
+        }
+    }
+    
+    // Runs along Z on each vertical lattice line
+    for (int x = 0; x <= maze->width && count < maxRects; x++) {
+        int y = 0;
+        while (y < maze->height && count < maxRects) {
+            if (!HasVerticalEdge(maze, x, y)) {
+                y++;
+                continue;
+            }
+            int start = y;
+            while (y < maze->height && HasVerticalEdge(maze, x, y)) y++;
+            
+            WallRect* w = &outRects[count++];
+            w->rect = (Rectangle){
+                originX + x * maze->cellSize - wallThick * 0.5f,
+                originZ + start * maze->cellSize - wallThick * 0.5f,
+                wallThick,
+                (y - start) * maze->cellSize + wallThick
+            };
+            w->isVertical = true;
+            w->x = x;
+            w->y = start;
+            w->length = y - start;
+            w->caps = 0;
+            if (!HasHorizontalEdge(maze, x - 1, start) && !HasHorizontalEdge(maze, x, start)) w->caps |= WALL_CAP_START;
+            if (!HasHorizontalEdge(maze, x - 1, y) && !HasHorizontalEdge(maze, x, y)) w->caps |= WALL_CAP_END;
         }
     }
     
     return count;
 }
 
+// Helper: Clamp float value
+static inline float clampf(float v, float lo, float hi) {
+    return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+
+// Helper: Circle vs axis-aligned rectangle in the XZ plane
+static bool CircleRectIntersect(Vector2 c, float r, Rectangle rect) {
+    float nx = clampf(c.x, rect.x, rect.x + rect.width);
+    float nz = clampf(c.y, rect.y, rect.y + rect.height);
+    float dx = c.x - nx;
+    float dz = c.y - nz;
+    return (dx*dx + dz*dz) <= r*r;
+}
+
+// Circle vs maze walls. Only the walls on lattice lines the circle can reach
+// are tested, using the same rectangles as Maze_GetWallRects, so the answer
+// matches a scan over that list at a cost independent of maze size.
+bool Maze_CollidesCircle(const Maze* maze, Vector2 center, float radius) {
+    if (!maze) return false;
+    
+    // Lattice range touched by the circle, padded by one cell so walls
+    // overhanging their corner by half a thickness are never missed
+    float reach = radius + COLLISION_WALL_THICK;
+    float originX = -maze->width * 0.5f * maze->cellSize;
+    float originZ = -maze->height * 0.5f * maze->cellSize;
+    int minX = (int)floorf((center.x - reach - originX) / maze->cellSize) - 1;
+    int maxX = (int)floorf((center.x + reach - originX) / maze->cellSize) + 1;
+    int minY = (int)floorf((center.y - reach - originZ) / maze->cellSize) - 1;
+    int maxY = (int)floorf((center.y + reach - originZ) / maze->cellSize) + 1;
+    if (minX < 0) minX = 0;
+    if (minY < 0) minY = 0;
+    if (maxX > maze->width) maxX = maze->width;
+    if (maxY > maze->height) maxY = maze->height;
+    
+    for (int y = minY; y <= maxY; y++) {
+        for (int x = minX; x <= maxX; x++) {
+            // Horizontal wall on the north edge of cell (x, y)
+            if (x < maze->width) {
+                if (y < maze->height) {
+                    if (Maze_HasWall(maze, x, y, MAZE_NORTH) &&
+                        CircleRectIntersect(center, radius, EdgeRect(maze, x, y, MAZE_NORTH))) return true;
+                } else if (Maze_HasWall(maze, x, y - 1, MAZE_SOUTH) &&
+                           CircleRectIntersect(center, radius, EdgeRect(maze, x, y - 1, MAZE_SOUTH))) {
+                    return true;
+                }
+            }
+            
+            // Vertical wall on the west edge of cell (x, y)
+            if (y < maze->height) {
+                if (x < maze->width) {
+                    if (Maze_HasWall(maze, x, y, MAZE_WEST) &&
+                        CircleRectIntersect(center, radius, EdgeRect(maze, x, y, MAZE_WEST))) return true;
+                } else if (Maze_HasWall(maze, x - 1, y, MAZE_EAST) &&
+                           CircleRectIntersect(center, radius, EdgeRect(maze, x - 1, y, MAZE_EAST))) {
+                    return true;
+                }
+            }
+        }
+    }
+    
+    return false;
+}
+
 // Convert cell coordinates to world position (center of cell)
 Vector2 Maze_CellToWorld(const Maze* maze, int cellX, int cellY) {
     return (Vector2){
@@ -0,0 +1,260 @@
+#define _POSIX_C_SOURCE 200809L
+#include "../include/maze.h"
+#include "../include/filemap.h"
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// Helper: Header followed by zero padding up to the payload
+static bool WriteHeader(FILE* file, const MazeFileHeader* header) {
+    static const unsigned char padding[MAZE_FILE_ALIGN] = {0};
+    return fwrite(header, sizeof(*header), 1, file) == 1 &&
+           fwrite(padding, 1, MAZE_FILE_ALIGN - sizeof(*header), file) == MAZE_FILE_ALIGN - sizeof(*header);
+}
+
+// Write a maze to a binary maze file. Stored mazes keep their layout;
+// source-backed ones are written row-major through Maze_GetCell.
+bool Maze_Save(const Maze* maze, const char* path) {
+    if (!maze || !path) return false;
+
+    const unsigned char* payload = maze->cells ? maze->cells : maze->edges;
+    MazeFileHeader header = {0};
+    memcpy(header.magic, MAZE_FILE_MAGIC, 4);
+    header.version = MAZE_FILE_VERSION;
+    header.width = (uint32_t)maze->width;
+    header.height = (uint32_t)maze->height;
+    header.storage = payload ? (uint32_t)maze->storage : MAZE_STORAGE_BYTES;
+    header.cellSize = maze->cellSize;
+    header.startX = maze->startPos.x;
+    header.startY = maze->startPos.y;
+    header.exitX = maze->exitPos.x;
+    header.exitY = maze->exitPos.y;
+    header.seed = maze->seed;
+    header.payloadOffset = MAZE_FILE_ALIGN;
+    header.payloadSize = payload ? Maze_StorageSize(maze) : (uint64_t)maze->width * maze->height;
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        TraceLog(LOG_WARNING, "Could not create maze file %s", path);
+        return false;
+    }
+
+    bool ok = WriteHeader(file, &header);
+    if (ok && payload) {
+        ok = fwrite(payload, 1, (size_t)header.payloadSize, file) == (size_t)header.payloadSize;
+    } else if (ok) {
+        unsigned char* row = (unsigned char*)malloc((size_t)maze->width);
+        ok = row != NULL;
+        for (int y = 0; ok && y < maze->height; y++) {
+            for (int x = 0; x < maze->width; x++) row[x] = Maze_GetCell(maze, x, y);
+            ok = fwrite(row, 1, (size_t)maze->width, file) == (size_t)maze->width;
+        }
+        free(row);
+    }
+    if (fclose(file) != 0) ok = false;
+
+    if (!ok) {
+        TraceLog(LOG_WARNING, "Failed to write maze file %s", path);
+        remove(path);
+    }
+    return ok;
+}
+
+// State of a maze being streamed to disk
+typedef struct {
+    FILE* file;
+    int width;
+    unsigned char* packed;  // One packed row
+    bool ok;
+} FileStream;
+
+// Helper: Row sink that packs a row and appends it to the file
+static void WritePackedRow(void* user, int y, const unsigned char* row) {
+    FileStream* stream = (FileStream*)user;
+    (void)y;
+    if (!stream->ok) return;
+
+    // Padding cells past the last column stay walled, as after Maze_Reset
+    const size_t stride = MAZE_PACKED_STRIDE(stream->width);
+    memset(stream->packed, 0xFF, stride);
+    for (int x = 0; x < stream->width; x++) {
+        unsigned int bits = ((row[x] & MAZE_NORTH) ? MAZE_PACKED_NORTH : 0) | ((row[x] & MAZE_WEST) ? MAZE_PACKED_WEST : 0);
+        int shift = (x & 3) * 2;
+        stream->packed[x >> 2] = (unsigned char)((stream->packed[x >> 2] & ~(3u << shift)) | bits << shift);
+    }
+    stream->ok = fwrite(stream->packed, 1, stride, stream->file) == stride;
+}
+
+// Generate a maze straight into a packed maze file with Eller's algorithm,
+// for mazes too large to hold in memory. Only O(width) state is kept, and
+// the result equals Maze_GenerateWith(MAZE_ALGO_ELLER) seeded from the
+// (seed, RNG_STREAM_MAZE, 0) stream. Open the file with Maze_Map, or with
+// MazeWindow_Map when it is larger than memory.
+bool Maze_GenerateToFile(const char* path, int width, int height, float cellSize, uint64_t seed) {
+    if (!path || width < 1 || height < 1 || cellSize <= 0.0f) return false;
+
+    MazeFileHeader header = {0};
+    memcpy(header.magic, MAZE_FILE_MAGIC, 4);
+    header.version = MAZE_FILE_VERSION;
+    header.width = (uint32_t)width;
+    header.height = (uint32_t)height;
+    header.storage = MAZE_STORAGE_PACKED;
+    header.cellSize = cellSize;
+    header.exitX = (float)(width - 1);
+    header.exitY = (float)(height - 1);
+    header.seed = seed;
+    header.payloadOffset = MAZE_FILE_ALIGN;
+    header.payloadSize = MAZE_PACKED_STRIDE(width) * (uint64_t)height;
+
+    FileStream stream = {0};
+    stream.file = fopen(path, "wb");
+    stream.width = width;
+    stream.packed = (unsigned char*)malloc(MAZE_PACKED_STRIDE(width));
+    if (!stream.file || !stream.packed) {
+        TraceLog(LOG_WARNING, "Could not create maze file %s", path);
+        if (stream.file) fclose(stream.file);
+        free(stream.packed);
+        return false;
+    }
+    setvbuf(stream.file, NULL, _IOFBF, 1 << 20);
+
+    Rng rng = Rng_ForStream(seed, RNG_STREAM_MAZE, 0);
+    stream.ok = WriteHeader(stream.file, &header);
+    if (stream.ok && !Maze_StreamEller(width, height, &rng, WritePackedRow, &stream)) stream.ok = false;
+    if (fclose(stream.file) != 0) stream.ok = false;
+    free(stream.packed);
+
+    if (!stream.ok) {
+        TraceLog(LOG_WARNING, "Failed to write maze file %s", path);
+        remove(path);
+    }
+    return stream.ok;
+}
+
+// Helper: Check a header against the file it came from
+static bool ValidHeader(const MazeFileHeader* header, size_t fileSize) {
+    if (fileSize < sizeof(MazeFileHeader)) return false;
+    if (memcmp(header->magic, MAZE_FILE_MAGIC, 4) != 0 || header->version != MAZE_FILE_VERSION) return false;
+    if (header->width < 1 || header->height < 1 || header->width > INT_MAX || header->height > INT_MAX) return false;
+    if (header->storage > MAZE_STORAGE_MORTON) return false;
+    if (!(header->cellSize > 0.0f) || !isfinite(header->cellSize)) return false;
+    if (!(header->startX >= 0.0f && header->startX < header->width && header->startY >= 0.0f &&
+          header->startY < header->height && header->exitX >= 0.0f && header->exitX < header->width &&
+          header->exitY >= 0.0f && header->exitY < header->height)) return false;
+    if (header->payloadOffset < sizeof(MazeFileHeader) || header->payloadOffset % 64 != 0) return false;
+    return header->payloadOffset <= fileSize && header->payloadSize <= fileSize - header->payloadOffset;
+}
+
+// Helper: Maze described by a valid header (no storage attached), or NULL
+// if the payload is not exactly the array its layout expects
+static Maze* MazeFromHeader(const MazeFileHeader* header) {
+    Maze* maze = (Maze*)calloc(1, sizeof(Maze));
+    if (!maze) return NULL;
+    maze->width = (int)header->width;
+    maze->height = (int)header->height;
+    maze->storage = (MazeStorage)header->storage;
+    maze->cellSize = header->cellSize;
+    maze->startPos = (Vector2){header->startX, header->startY};
+    maze->exitPos = (Vector2){header->exitX, header->exitY};
+    maze->seed = header->seed;
+    if (Maze_StorageSize(maze) != header->payloadSize) {
+        free(maze);
+        return NULL;
+    }
+    return maze;
+}
+
+// Helper: Check that every edge cell keeps its outer wall; the game walks
+// neighbours of any open side without a bounds check. O(width + height).
+static bool ClosedPerimeter(const Maze* maze) {
+    for (int x = 0; x < maze->width; x++) {
+        if (!Maze_HasWall(maze, x, 0, MAZE_NORTH) || !Maze_HasWall(maze, x, maze->height - 1, MAZE_SOUTH)) {
+            return false;
+        }
+    }
+    for (int y = 0; y < maze->height; y++) {
+        if (!Maze_HasWall(maze, 0, y, MAZE_WEST) || !Maze_HasWall(maze, maze->width - 1, y, MAZE_EAST)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Read and validate the header of a maze file without touching its payload
+bool Maze_ReadFileHeader(const char* path, MazeFileHeader* outHeader) {
+    FILE* file = path ? fopen(path, "rb") : NULL;
+    if (!file) return false;
+
+    bool ok = fread(outHeader, sizeof(*outHeader), 1, file) == 1;
+    uint64_t size = 0;
+#ifdef _WIN32
+    if (ok && _fseeki64(file, 0, SEEK_END) == 0) size = (uint64_t)_ftelli64(file);
+#else
+    struct stat st;
+    if (ok && fstat(fileno(file), &st) == 0) size = (uint64_t)st.st_size;
+#endif
+    fclose(file);
+
+    Maze* maze = ok && size <= SIZE_MAX && ValidHeader(outHeader, (size_t)size) ? MazeFromHeader(outHeader) : NULL;
+    free(maze);
+    return maze != NULL;
+}
+
+// Open a maze file without reading it: the file is mapped and the payload
+// backs cells (or edges) directly, so loading costs no parsing or copying
+// and pages are read as the game first touches them. Only the outer wall is
+// checked up front; a file with an opening in it is refused. Release the
+// maze with Maze_Unmap or Maze_Destroy.
+Maze* Maze_Map(const char* path) {
+    if (!path) return NULL;
+
+    size_t size = 0;
+    unsigned char* view = (unsigned char*)FileMap_Open(path, &size);
+    if (!view) {
+        TraceLog(LOG_WARNING, "Could not open maze file %s", path);
+        return NULL;
+    }
+
+    const MazeFileHeader* header = (const MazeFileHeader*)view;
+    Maze* maze = ValidHeader(header, size) ? MazeFromHeader(header) : NULL;
+    if (!maze) {
+        TraceLog(LOG_WARNING, "%s is not a valid version %d maze file", path, MAZE_FILE_VERSION);
+        FileMap_Close(view, size);
+        return NULL;
+    }
+
+    if (maze->storage == MAZE_STORAGE_PACKED) {
+        maze->edges = view + header->payloadOffset;
+    } else {
+        maze->cells = view + header->payloadOffset;
+    }
+    maze->mapping = view;
+    maze->mappingSize = size;
+    if (!ClosedPerimeter(maze)) {
+        TraceLog(LOG_WARNING, "%s has an opening in its outer wall", path);
+        Maze_Unmap(maze);
+        return NULL;
+    }
+#ifndef _WIN32
+    posix_madvise(view, size, POSIX_MADV_WILLNEED);
+#endif
+    return maze;
+}
+
+// Release a maze opened with Maze_Map (other mazes are simply destroyed)
+void Maze_Unmap(Maze* maze) {
+    if (!maze) return;
+    if (!maze->mapping) {
+        Maze_Destroy(maze);
+        return;
+    }
+    FileMap_Close(maze->mapping, maze->mappingSize);
+    free(maze);
+}
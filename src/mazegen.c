@@ -0,0 +1,397 @@
+#include "../include/maze.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Scratch bits above the wall flags, used by Wilson's walk and cleared after
+#define CELL_WALK_SHIFT 4       // Bits 4-5: direction of the current walk
+#define CELL_IN_TREE    0x40    // Cell already joined the spanning tree
+
+static const char* s_algorithmNames[MAZE_ALGO_COUNT] = {"backtracker", "eller", "kruskal", "wilson"};
+
+// Name of an algorithm (as accepted by Maze_AlgorithmFromName)
+const char* Maze_AlgorithmName(MazeAlgorithm algorithm) {
+    if (algorithm < 0 || algorithm >= MAZE_ALGO_COUNT) return "unknown";
+    return s_algorithmNames[algorithm];
+}
+
+// Look up an algorithm by name; returns false if the name is unknown
+bool Maze_AlgorithmFromName(const char* name, MazeAlgorithm* outAlgorithm) {
+    for (int i = 0; name && i < MAZE_ALGO_COUNT; i++) {
+        if (strcmp(name, s_algorithmNames[i]) == 0) {
+            *outAlgorithm = (MazeAlgorithm)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Helper: Union-find root with path halving
+static uint32_t FindRoot(uint32_t* parent, uint32_t i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+// Helper: Scratch bytes of Eller's algorithm for a row of width cells
+static size_t EllerScratchSize(int width) {
+    return (size_t)width * (3 * sizeof(uint32_t) + 3);
+}
+
+// Helper: Eller's algorithm over caller scratch (EllerScratchSize bytes)
+static void StreamEller(int width, int height, Rng* rng, MazeRowSink sink, void* user, void* scratch) {
+    uint32_t* parent = (uint32_t*)scratch;
+    uint32_t* remaining = parent + width;
+    uint32_t* nextRep = remaining + width;
+    unsigned char* hasDown = (unsigned char*)(nextRep + width);
+    unsigned char* row = hasDown + width;
+    unsigned char* openNorth = row + width;
+    memset(openNorth, 0, (size_t)width);
+
+    // First row: every cell is its own set
+    for (int x = 0; x < width; x++) parent[x] = (uint32_t)x;
+
+    for (int y = 0; y < height; y++) {
+        bool lastRow = (y == height - 1);
+        for (int x = 0; x < width; x++) {
+            row[x] = openNorth[x] ? (MAZE_ALL & ~MAZE_NORTH) : MAZE_ALL;
+        }
+
+        // Join neighbours in different sets (all of them on the last row)
+        for (int x = 0; x + 1 < width; x++) {
+            uint32_t a = FindRoot(parent, (uint32_t)x);
+            uint32_t b = FindRoot(parent, (uint32_t)x + 1);
+            if (a == b || (!lastRow && (Rng_Next(rng) & 1))) continue;
+            parent[b] = a;
+            row[x] &= (unsigned char)~MAZE_EAST;
+            row[x + 1] &= (unsigned char)~MAZE_WEST;
+        }
+
+        if (!lastRow) {
+            // Every set carries on into the next row through at least one
+            // cell: force the drop on a set's last cell if none happened
+            for (int x = 0; x < width; x++) {
+                remaining[x] = 0;
+                hasDown[x] = 0;
+                nextRep[x] = UINT32_MAX;
+            }
+            for (int x = 0; x < width; x++) remaining[FindRoot(parent, (uint32_t)x)]++;
+
+            for (int x = 0; x < width; x++) {
+                uint32_t root = FindRoot(parent, (uint32_t)x);
+                remaining[root]--;
+                bool down = (Rng_Next(rng) & 1) || (remaining[root] == 0 && !hasDown[root]);
+                openNorth[x] = down;
+                if (!down) continue;
+
+                hasDown[root] = 1;
+                row[x] &= (unsigned char)~MAZE_SOUTH;
+                if (nextRep[root] == UINT32_MAX) nextRep[root] = (uint32_t)x;
+            }
+        }
+
+        sink(user, y, row);
+        if (lastRow) break;
+
+        // Next row: dropped cells keep their set (re-rooted at the set's
+        // first dropped column), the rest start fresh
+        for (int x = 0; x < width; x++) {
+            remaining[x] = openNorth[x] ? nextRep[FindRoot(parent, (uint32_t)x)] : (uint32_t)x;
+        }
+        memcpy(parent, remaining, (size_t)width * sizeof(uint32_t));
+    }
+}
+
+// Stream a maze row by row with Eller's algorithm. Only the current row's
+// sets are kept (O(width) memory), so rows can be written out as soon as
+// they are finished. Each emitted row holds MAZE_* wall flags per cell.
+bool Maze_StreamEller(int width, int height, Rng* rng, MazeRowSink sink, void* user) {
+    if (width < 1 || height < 1 || !rng || !sink) return false;
+
+    void* scratch = malloc(EllerScratchSize(width));
+    if (!scratch) return false;
+    StreamEller(width, height, rng, sink, user, scratch);
+    free(scratch);
+    return true;
+}
+
+// Helper: Row sink that stores into a maze (either layout)
+static void CopyRowToMaze(void* user, int y, const unsigned char* row) {
+    Maze* maze = (Maze*)user;
+    Maze_SetRow(maze, y, 0, maze->width, row);
+}
+
+// Direction codes 0..3 in MAZE_NORTH, MAZE_EAST, MAZE_SOUTH, MAZE_WEST order
+static const unsigned char s_dirBits[4] = {MAZE_NORTH, MAZE_EAST, MAZE_SOUTH, MAZE_WEST};
+
+// Helper: Index of the n-th set bit of a 4-bit mask
+static int NthSetBit(unsigned int mask, int n) {
+    for (int i = 0; i < 4; i++) {
+        if ((mask & (1u << i)) && n-- == 0) return i;
+    }
+    return 0;
+}
+
+// Helper: Iterative DFS backtracking. A cell still enclosed by all four
+// walls is unvisited (the start cell loses one on the first step), so the
+// wall bits double as the visited set; the stack holds only the 2-bit
+// direction used to enter each cell (cellCount / 4 bytes), and backtracking
+// walks that direction in reverse.
+static bool GenerateBacktracker(Maze* maze, Rng* rng, unsigned char* stack) {
+    const int width = maze->width;
+    const int height = maze->height;
+    unsigned char* cells = maze->cells;
+
+    // Start from (0, 0)
+    int x = 0, y = 0;
+    size_t idx = Maze_CellOffset(maze, 0, 0);
+    size_t depth = 0;
+
+    for (;;) {
+        // Unvisited neighbours as a mask of direction codes
+        unsigned int open = 0;
+        if (y > 0 && cells[Maze_CellOffset(maze, x, y - 1)] == MAZE_ALL) open |= 1u << 0;
+        if (x < width - 1 && cells[Maze_CellOffset(maze, x + 1, y)] == MAZE_ALL) open |= 1u << 1;
+        if (y < height - 1 && cells[Maze_CellOffset(maze, x, y + 1)] == MAZE_ALL) open |= 1u << 2;
+        if (x > 0 && cells[Maze_CellOffset(maze, x - 1, y)] == MAZE_ALL) open |= 1u << 3;
+
+        if (open) {
+            int choices = (open & 1) + ((open >> 1) & 1) + ((open >> 2) & 1) + ((open >> 3) & 1);
+            int dir = NthSetBit(open, (int)Rng_Range(rng, (uint32_t)choices));
+
+            // Remove walls between current and neighbor
+            cells[idx] &= (unsigned char)~s_dirBits[dir];
+            switch (dir) {
+                case 0: y--; break;
+                case 1: x++; break;
+                case 2: y++; break;
+                default: x--; break;
+            }
+            idx = Maze_CellOffset(maze, x, y);
+            cells[idx] &= (unsigned char)~s_dirBits[(dir + 2) & 3];
+
+            stack[depth >> 2] = (unsigned char)((stack[depth >> 2] & ~(3u << ((depth & 3) * 2))) | (unsigned)dir << ((depth & 3) * 2));
+            depth++;
+        } else {
+            // Backtrack
+            if (depth == 0) break;
+            depth--;
+            int dir = (stack[depth >> 2] >> ((depth & 3) * 2)) & 3;
+            switch (dir) {
+                case 0: y++; break;
+                case 1: x--; break;
+                case 2: y--; break;
+                default: x++; break;
+            }
+            idx = Maze_CellOffset(maze, x, y);
+        }
+    }
+    return true;
+}
+
+// Helper: Kruskal's algorithm. Shuffles every interior edge and opens those
+// joining two different trees. The scratch holds a union-find parent per
+// cell and the edge order (4 bytes each).
+static bool GenerateKruskal(Maze* maze, Rng* rng, void* scratch) {
+    const uint32_t width = (uint32_t)maze->width;
+    const uint32_t height = (uint32_t)maze->height;
+    const size_t cellCount = (size_t)width * height;
+    const size_t eastEdges = (size_t)(width - 1) * height;
+    const size_t edgeCount = eastEdges + (size_t)width * (height - 1);
+    if (cellCount > UINT32_MAX || edgeCount > UINT32_MAX) return false;
+
+    uint32_t* parent = (uint32_t*)scratch;
+    uint32_t* edges = parent + cellCount;
+    for (size_t i = 0; i < cellCount; i++) parent[i] = (uint32_t)i;
+    for (size_t i = 0; i < edgeCount; i++) edges[i] = (uint32_t)i;
+
+    // Process edges in random order: a lazy Fisher-Yates shuffle
+    size_t joined = 0;
+    for (size_t i = 0; i < edgeCount && joined + 1 < cellCount; i++) {
+        size_t j = i + Rng_Range(rng, (uint32_t)(edgeCount - i));
+        uint32_t e = edges[j];
+        edges[j] = edges[i];
+
+        uint32_t ax, ay, bx, by;
+        int dir;
+        if (e < eastEdges) {
+            ay = by = e / (width - 1);
+            ax = e % (width - 1);
+            bx = ax + 1;
+            dir = MAZE_EAST;
+        } else {
+            ay = (e - (uint32_t)eastEdges) / width;
+            ax = bx = (e - (uint32_t)eastEdges) % width;
+            by = ay + 1;
+            dir = MAZE_SOUTH;
+        }
+
+        uint32_t ra = FindRoot(parent, ay * width + ax);
+        uint32_t rb = FindRoot(parent, by * width + bx);
+        if (ra == rb) continue;
+        parent[rb] = ra;
+        joined++;
+
+        maze->cells[Maze_CellOffset(maze, (int)ax, (int)ay)] &= (unsigned char)~dir;
+        maze->cells[Maze_CellOffset(maze, (int)bx, (int)by)] &= (unsigned char)(dir == MAZE_EAST ? ~MAZE_WEST : ~MAZE_NORTH);
+    }
+    return true;
+}
+
+// Helper: Wilson's algorithm. Loop-erased random walks from each cell not in
+// the tree until they hit it, giving a uniformly random spanning tree. The
+// walk directions and the in-tree mark live in spare bits of the cells.
+static bool GenerateWilson(Maze* maze, Rng* rng) {
+    static const unsigned char dirBits[4] = {MAZE_NORTH, MAZE_EAST, MAZE_SOUTH, MAZE_WEST};
+    const int width = maze->width;
+    const int height = maze->height;
+    const size_t cellCount = (size_t)width * height;
+    unsigned char* cells = maze->cells;
+
+    size_t root = cellCount > UINT32_MAX ? 0 : Rng_Range(rng, (uint32_t)cellCount);
+    cells[Maze_CellOffset(maze, (int)(root % width), (int)(root / width))] |= CELL_IN_TREE;
+
+    for (int startY = 0; startY < height; startY++) {
+        for (int startX = 0; startX < width; startX++) {
+            if (cells[Maze_CellOffset(maze, startX, startY)] & CELL_IN_TREE) continue;
+
+            // Random walk, remembering only the last exit from each cell;
+            // later exits overwrite earlier ones, which erases the loops
+            int x = startX, y = startY;
+            size_t idx = Maze_CellOffset(maze, x, y);
+            while (!(cells[idx] & CELL_IN_TREE)) {
+                int dir;
+                for (;;) {
+                    dir = (int)(Rng_Next(rng) & 3);
+                    if ((dir == 0 && y > 0) || (dir == 1 && x < width - 1) ||
+                        (dir == 2 && y < height - 1) || (dir == 3 && x > 0)) break;
+                }
+                cells[idx] = (unsigned char)((cells[idx] & ~(3u << CELL_WALK_SHIFT)) | (unsigned)dir << CELL_WALK_SHIFT);
+                switch (dir) {
+                    case 0: y--; break;
+                    case 1: x++; break;
+                    case 2: y++; break;
+                    default: x--; break;
+                }
+                idx = Maze_CellOffset(maze, x, y);
+            }
+
+            // Replay the loop-erased path and carve it into the tree
+            x = startX;
+            y = startY;
+            idx = Maze_CellOffset(maze, x, y);
+            while (!(cells[idx] & CELL_IN_TREE)) {
+                int dir = (cells[idx] >> CELL_WALK_SHIFT) & 3;
+                cells[idx] = (unsigned char)((cells[idx] & ~dirBits[dir]) | CELL_IN_TREE);
+                switch (dir) {
+                    case 0: y--; break;
+                    case 1: x++; break;
+                    case 2: y++; break;
+                    default: x--; break;
+                }
+                idx = Maze_CellOffset(maze, x, y);
+                cells[idx] &= (unsigned char)~dirBits[(dir + 2) & 3];
+            }
+        }
+    }
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) cells[Maze_CellOffset(maze, x, y)] &= MAZE_ALL;
+    }
+    return true;
+}
+
+// Helper: Scratch bytes of an algorithm on a byte-per-cell maze
+static size_t CellScratchSize(int width, int height, MazeAlgorithm algorithm) {
+    const size_t cellCount = (size_t)width * height;
+    switch (algorithm) {
+        case MAZE_ALGO_ELLER:
+            return EllerScratchSize(width);
+        case MAZE_ALGO_KRUSKAL:
+            // One parent per cell plus one entry per interior edge
+            return (cellCount + 2 * cellCount - width - height + 1) * sizeof(uint32_t);
+        case MAZE_ALGO_WILSON:
+            return 0;       // Walk state lives in spare cell bits
+        default:
+            return (cellCount + 3) / 4;
+    }
+}
+
+// Helper: Run an algorithm on a byte-per-cell maze (any cell layout)
+static bool GenerateCells(Maze* maze, MazeAlgorithm algorithm, Rng* rng, void* scratch) {
+    switch (algorithm) {
+        case MAZE_ALGO_ELLER:
+            StreamEller(maze->width, maze->height, rng, CopyRowToMaze, maze, scratch);
+            return true;
+        case MAZE_ALGO_KRUSKAL:
+            return GenerateKruskal(maze, rng, scratch);
+        case MAZE_ALGO_WILSON:
+            return GenerateWilson(maze, rng);
+        default:
+            return GenerateBacktracker(maze, rng, (unsigned char*)scratch);
+    }
+}
+
+// Scratch bytes Maze_GenerateInto needs for a maze of this size and layout.
+// Packed mazes stream Eller straight into their rows; the other algorithms
+// need random access to whole cells, so they run on a byte copy in the
+// scratch that is packed afterwards.
+size_t Maze_GenerateScratchSize(int width, int height, MazeStorage storage, MazeAlgorithm algorithm) {
+    if (width < 1 || height < 1) return 0;
+    size_t cells = CellScratchSize(width, height, algorithm);
+    if (storage != MAZE_STORAGE_PACKED || algorithm == MAZE_ALGO_ELLER) return cells;
+    return (((size_t)width * height + 7) & ~(size_t)7) + cells;
+}
+
+// Generate a perfect maze with the chosen algorithm into caller-owned
+// scratch of Maze_GenerateScratchSize bytes, so repeated generation (chunk
+// caches, tiles) allocates nothing. Returns false, leaving the maze fully
+// walled, if the scratch is too small or the maze too large for the
+// algorithm.
+bool Maze_GenerateInto(Maze* maze, MazeAlgorithm algorithm, Rng* rng, void* scratch, size_t scratchSize) {
+    if (!maze || (!maze->cells && !maze->edges) || !rng) return false;
+
+    Maze_Reset(maze);
+    if (scratchSize < Maze_GenerateScratchSize(maze->width, maze->height, maze->storage, algorithm)) return false;
+    if (!maze->edges || algorithm == MAZE_ALGO_ELLER) {
+        if (GenerateCells(maze, algorithm, rng, scratch)) return true;
+        Maze_Reset(maze);
+        return false;
+    }
+
+    const size_t cellBytes = ((size_t)maze->width * maze->height + 7) & ~(size_t)7;
+    Maze bytes = {0};
+    bytes.width = maze->width;
+    bytes.height = maze->height;
+    bytes.cellSize = maze->cellSize;
+    bytes.storage = MAZE_STORAGE_BYTES;
+    bytes.cells = (unsigned char*)scratch;
+    Maze_Reset(&bytes);
+    if (!GenerateCells(&bytes, algorithm, rng, (unsigned char*)scratch + cellBytes)) {
+        Maze_Reset(maze);
+        return false;
+    }
+    for (int y = 0; y < maze->height; y++) {
+        Maze_SetRow(maze, y, 0, maze->width, &bytes.cells[(size_t)y * maze->width]);
+    }
+    return true;
+}
+
+// Generate a perfect maze with the chosen algorithm. Returns false (leaving
+// the maze fully walled) if the algorithm runs out of memory.
+bool Maze_GenerateWith(Maze* maze, MazeAlgorithm algorithm, Rng* rng) {
+    if (!maze || (!maze->cells && !maze->edges) || !rng) return false;
+
+    size_t size = Maze_GenerateScratchSize(maze->width, maze->height, maze->storage, algorithm);
+    void* scratch = malloc(size > 0 ? size : 1);
+    bool ok = scratch && Maze_GenerateInto(maze, algorithm, rng, scratch, size);
+    free(scratch);
+    if (!ok) {
+        TraceLog(LOG_ERROR, "Out of memory generating %dx%d maze with %s", maze->width, maze->height,
+                 Maze_AlgorithmName(algorithm));
+        Maze_Reset(maze);
+    }
+    return ok;
+}
@@ -0,0 +1,617 @@
+#include "../include/mazemesh.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define VERTS_PER_FACE     4
+#define INDICES_PER_FACE   6
+#define MESH_BUFFER_INDICES 6      // Slot of the index buffer in Mesh.vboId
+
+// Axis-aligned wall box footprint in the XZ plane
+typedef struct {
+    float x0, z0, x1, z1;
+} WallBox;
+
+// Piece of a merged wall run that falls inside one chunk
+typedef struct {
+    WallRect run;       // Lattice span of the piece; caps only at real run ends
+    int chunk;
+    bool extendStart;   // Piece starts at the run start (close the corner)
+    bool extendEnd;     // Piece ends at the run end
+} WallPiece;
+
+// Faces of a wall box that can actually be seen
+#define FACE_NEG_X 0x01
+#define FACE_POS_X 0x02
+#define FACE_NEG_Z 0x04
+#define FACE_POS_Z 0x08
+
+// Helper: Append one quad. R runs along the face, cross(R, up) must face outward.
+static void EmitQuad(Mesh* mesh, int* vertCount, int* indexCount,
+                     Vector3 p, Vector3 r, float height, float uSpan) {
+    int base = *vertCount;
+    float* v = &mesh->vertices[base * 3];
+    float* t = &mesh->texcoords[base * 2];
+
+    Vector3 corners[4] = {
+        p,
+        (Vector3){p.x + r.x, p.y, p.z + r.z},
+        (Vector3){p.x + r.x, p.y + height, p.z + r.z},
+        (Vector3){p.x, p.y + height, p.z}
+    };
+    float uvs[8] = {0.0f, 1.0f, uSpan, 1.0f, uSpan, 0.0f, 0.0f, 0.0f};
+
+    for (int i = 0; i < 4; i++) {
+        v[i * 3 + 0] = corners[i].x;
+        v[i * 3 + 1] = corners[i].y;
+        v[i * 3 + 2] = corners[i].z;
+    }
+    memcpy(t, uvs, sizeof(uvs));
+
+    unsigned short* idx = &mesh->indices[*indexCount];
+    idx[0] = (unsigned short)(base + 0);
+    idx[1] = (unsigned short)(base + 1);
+    idx[2] = (unsigned short)(base + 2);
+    idx[3] = (unsigned short)(base + 0);
+    idx[4] = (unsigned short)(base + 2);
+    idx[5] = (unsigned short)(base + 3);
+
+    *vertCount += 4;
+    *indexCount += 6;
+}
+
+// Helper: Append the visible side faces of a wall box (top and bottom are
+// hidden by the ceiling and floor)
+static void EmitWallBox(Mesh* mesh, int* vertCount, int* indexCount, WallBox box,
+                        unsigned char faces, float height, float cellSize) {
+    float w = box.x1 - box.x0;
+    float d = box.z1 - box.z0;
+    
+    // Keep one texture repeat per cell along long runs
+    float uX = w / cellSize;
+    float uZ = d / cellSize;
+
+    if (faces & FACE_NEG_Z) EmitQuad(mesh, vertCount, indexCount, (Vector3){box.x1, 0.0f, box.z0}, (Vector3){-w, 0.0f, 0.0f}, height, uX);
+    if (faces & FACE_POS_Z) EmitQuad(mesh, vertCount, indexCount, (Vector3){box.x0, 0.0f, box.z1}, (Vector3){w, 0.0f, 0.0f}, height, uX);
+    if (faces & FACE_NEG_X) EmitQuad(mesh, vertCount, indexCount, (Vector3){box.x0, 0.0f, box.z0}, (Vector3){0.0f, 0.0f, d}, height, uZ);
+    if (faces & FACE_POS_X) EmitQuad(mesh, vertCount, indexCount, (Vector3){box.x1, 0.0f, box.z1}, (Vector3){0.0f, 0.0f, -d}, height, uZ);
+}
+
+// Helper: Append a horizontal quad covering [x0, x1] x [z0, z1] at height y.
+// UVs span uSpan x vSpan repeats.
+static void EmitFlat(Mesh* mesh, int* vertCount, int* indexCount, float x0, float z0, float x1, float z1,
+                     float y, bool faceUp, float uSpan, float vSpan) {
+    int base = *vertCount;
+    float* v = &mesh->vertices[base * 3];
+    float* t = &mesh->texcoords[base * 2];
+
+    // Counter-clockwise as seen from above, so the normal points up
+    float corners[12] = {x0, y, z0, x0, y, z1, x1, y, z1, x1, y, z0};
+    float uvs[8] = {0.0f, 0.0f, 0.0f, vSpan, uSpan, vSpan, uSpan, 0.0f};
+    memcpy(v, corners, sizeof(corners));
+    memcpy(t, uvs, sizeof(uvs));
+
+    unsigned short* idx = &mesh->indices[*indexCount];
+    if (faceUp) {
+        idx[0] = (unsigned short)(base + 0); idx[1] = (unsigned short)(base + 1); idx[2] = (unsigned short)(base + 2);
+        idx[3] = (unsigned short)(base + 0); idx[4] = (unsigned short)(base + 2); idx[5] = (unsigned short)(base + 3);
+    } else {
+        idx[0] = (unsigned short)(base + 0); idx[1] = (unsigned short)(base + 2); idx[2] = (unsigned short)(base + 1);
+        idx[3] = (unsigned short)(base + 0); idx[4] = (unsigned short)(base + 3); idx[5] = (unsigned short)(base + 2);
+    }
+
+    *vertCount += 4;
+    *indexCount += 6;
+}
+
+// Helper: Render box and visible faces for a wall piece. Pieces at the ends
+// of a run are extended by half a thickness so corners close; end caps are
+// only kept when no perpendicular wall covers them, and border faces pointing
+// out of the maze are dropped.
+static unsigned char WallRunFaces(const Maze* maze, const WallPiece* piece, float wallThick, WallBox* outBox) {
+    const WallRect* wall = &piece->run;
+    const float originX = -maze->width * 0.5f * maze->cellSize;
+    const float originZ = -maze->height * 0.5f * maze->cellSize;
+    const float halfThick = wallThick * 0.5f;
+    const float startPad = piece->extendStart ? halfThick : 0.0f;
+    const float endPad = piece->extendEnd ? halfThick : 0.0f;
+    float lineX = originX + wall->x * maze->cellSize;
+    float lineZ = originZ + wall->y * maze->cellSize;
+    float span = wall->length * maze->cellSize;
+    unsigned char faces = 0;
+
+    if (wall->isVertical) {
+        *outBox = (WallBox){lineX - halfThick, lineZ - startPad, lineX + halfThick, lineZ + span + endPad};
+        if (wall->x > 0) faces |= FACE_NEG_X;
+        if (wall->x < maze->width) faces |= FACE_POS_X;
+        if (wall->caps & WALL_CAP_START) faces |= FACE_NEG_Z;
+        if (wall->caps & WALL_CAP_END) faces |= FACE_POS_Z;
+    } else {
+        *outBox = (WallBox){lineX - startPad, lineZ - halfThick, lineX + span + endPad, lineZ + halfThick};
+        if (wall->y > 0) faces |= FACE_NEG_Z;
+        if (wall->y < maze->height) faces |= FACE_POS_Z;
+        if (wall->caps & WALL_CAP_START) faces |= FACE_NEG_X;
+        if (wall->caps & WALL_CAP_END) faces |= FACE_POS_X;
+    }
+    return faces;
+}
+
+// Helper: Number of bits set in a face mask
+static int FaceCount(unsigned char faces) {
+    int n = 0;
+    for (; faces; faces &= (unsigned char)(faces - 1)) n++;
+    return n;
+}
+
+// Helper: Chunks needed to cover a span of cells
+static int ChunkSpan(int cells) {
+    return (cells + MAZE_CHUNK_CELLS - 1) / MAZE_CHUNK_CELLS;
+}
+
+// Helper: Chunk owning lattice edge k of a run. Edges on the south/east
+// border belong to the last row/column of cells.
+static int EdgeChunk(const MazeMeshBake* bake, const WallRect* wall, int k) {
+    int cx, cy;
+    if (wall->isVertical) {
+        cx = wall->x < bake->width ? wall->x : bake->width - 1;
+        cy = wall->y + k;
+    } else {
+        cx = wall->x + k;
+        cy = wall->y < bake->height ? wall->y : bake->height - 1;
+    }
+    return (cy / MAZE_CHUNK_CELLS) * ChunkSpan(bake->width) + cx / MAZE_CHUNK_CELLS;
+}
+
+// Helper: Cut merged runs at chunk borders. Returns the piece count; pieces
+// may be NULL to only count.
+static int SplitWallRuns(const MazeMeshBake* bake, const WallRect* walls, int wallCount, WallPiece* pieces) {
+    int count = 0;
+    for (int i = 0; i < wallCount; i++) {
+        int k0 = 0;
+        for (int k = 1; k <= walls[i].length; k++) {
+            if (k < walls[i].length && EdgeChunk(bake, &walls[i], k) == EdgeChunk(bake, &walls[i], k0)) continue;
+
+            if (pieces) {
+                WallPiece* p = &pieces[count];
+                p->run = walls[i];
+                p->run.x += walls[i].isVertical ? 0 : k0;
+                p->run.y += walls[i].isVertical ? k0 : 0;
+                p->run.length = k - k0;
+                p->extendStart = (k0 == 0);
+                p->extendEnd = (k == walls[i].length);
+                p->run.caps = 0;
+                if (p->extendStart) p->run.caps |= walls[i].caps & WALL_CAP_START;
+                if (p->extendEnd) p->run.caps |= walls[i].caps & WALL_CAP_END;
+                p->chunk = EdgeChunk(bake, &walls[i], k0);
+            }
+            count++;
+            k0 = k;
+        }
+    }
+    return count;
+}
+
+// Helper: Wrap a filled mesh into a textured model. Vertex data goes to the
+// GPU and the CPU pointers are dropped (the caller still owns those
+// buffers); only the indices stay on the CPU, for culled draws to compact.
+static Model UploadChunkModel(Mesh mesh, Texture2D texture) {
+    UploadMesh(&mesh, false);
+    mesh.vertices = NULL;
+    mesh.texcoords = NULL;
+
+    Model model = LoadModelFromMesh(mesh);
+    model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texture;
+    return model;
+}
+
+// Helper: Allocate CPU buffers for a mesh of quads. raylib frees mesh buffers
+// with RL_FREE, so allocate them with MemAlloc.
+static bool AllocQuads(Mesh* mesh, int quads) {
+    *mesh = (Mesh){0};
+    mesh->vertices = (float*)MemAlloc(quads * VERTS_PER_FACE * 3 * sizeof(float));
+    mesh->texcoords = (float*)MemAlloc(quads * VERTS_PER_FACE * 2 * sizeof(float));
+    mesh->indices = (unsigned short*)MemAlloc(quads * INDICES_PER_FACE * sizeof(unsigned short));
+    if (!mesh->vertices || !mesh->texcoords || !mesh->indices) {
+        MemFree(mesh->vertices);
+        MemFree(mesh->texcoords);
+        MemFree(mesh->indices);
+        return false;
+    }
+    return true;
+}
+
+// Helper: One-quad floor or ceiling model (meshCount 0 if out of memory)
+static Model FlatModel(float x0, float z0, float x1, float z1, float y, bool faceUp, float uSpan, float vSpan,
+                       Texture2D texture) {
+    Mesh flat;
+    if (!AllocQuads(&flat, 1)) return (Model){0};
+    int vertCount = 0, indexCount = 0;
+    EmitFlat(&flat, &vertCount, &indexCount, x0, z0, x1, z1, y, faceUp, uSpan, vSpan);
+    flat.vertexCount = vertCount;
+    flat.triangleCount = indexCount / 3;
+    Model model = UploadChunkModel(flat, texture);
+    MemFree(flat.vertices);
+    MemFree(flat.texcoords);
+    return model;
+}
+
+// Cut the merged wall runs into per-chunk pieces and emit each chunk's
+// visible wall quads on the CPU, without touching the GPU. Release the
+// arrays with MazeMesh_FreeBake.
+bool MazeMesh_Bake(const Maze* maze, const WallRect* walls, int wallCount, float wallHeight, float wallThick,
+                   MazeMeshBake* outBake) {
+    if (!maze || !walls || !outBake) return false;
+
+    MazeMeshBake* bake = outBake;
+    *bake = (MazeMeshBake){0};
+    const int width = maze->width;
+    const int height = maze->height;
+    bake->width = width;
+    bake->height = height;
+    bake->chunkCount = ChunkSpan(width) * ChunkSpan(height);
+
+    int pieceCount = SplitWallRuns(bake, walls, wallCount, NULL);
+    int pieceSlots = pieceCount > 0 ? pieceCount : 1;
+    bake->pieceCount = pieceCount;
+    bake->chunks = (MazeMeshBakeChunk*)calloc(bake->chunkCount > 0 ? bake->chunkCount : 1, sizeof(MazeMeshBakeChunk));
+    bake->wallChunk = (int*)malloc(pieceSlots * sizeof(int));
+    bake->wallFirstIndex = (int*)malloc(pieceSlots * sizeof(int));
+    bake->wallIndexCount = (unsigned char*)malloc(pieceSlots);
+    bake->horizontalEdgeWall = (int*)malloc((size_t)width * (height + 1) * sizeof(int));
+    bake->verticalEdgeWall = (int*)malloc((size_t)(width + 1) * height * sizeof(int));
+
+    WallPiece* unsorted = (WallPiece*)malloc(pieceSlots * sizeof(WallPiece));
+    WallPiece* pieces = (WallPiece*)malloc(pieceSlots * sizeof(WallPiece));
+    unsigned char* faces = (unsigned char*)malloc(pieceSlots);
+    WallBox* boxes = (WallBox*)malloc(pieceSlots * sizeof(WallBox));
+    if (!unsorted || !pieces || !faces || !boxes || !bake->chunks || !bake->wallChunk || !bake->wallFirstIndex ||
+        !bake->wallIndexCount || !bake->horizontalEdgeWall || !bake->verticalEdgeWall) {
+        free(unsorted);
+        free(pieces);
+        free(faces);
+        free(boxes);
+        MazeMesh_FreeBake(bake);
+        return false;
+    }
+
+    // Group pieces by chunk (counting sort keeps each chunk contiguous)
+    SplitWallRuns(bake, walls, wallCount, unsorted);
+    for (int i = 0; i < pieceCount; i++) bake->chunks[unsorted[i].chunk].wallCount++;
+    int offset = 0;
+    for (int c = 0; c < bake->chunkCount; c++) {
+        bake->chunks[c].firstWall = offset;
+        offset += bake->chunks[c].wallCount;
+        bake->chunks[c].wallCount = 0;
+    }
+    for (int i = 0; i < pieceCount; i++) {
+        MazeMeshBakeChunk* chunk = &bake->chunks[unsorted[i].chunk];
+        pieces[chunk->firstWall + chunk->wallCount++] = unsorted[i];
+    }
+    free(unsorted);
+
+    // Map every lattice edge to the wall piece covering it, for culled draws
+    for (size_t i = 0; i < (size_t)width * (height + 1); i++) bake->horizontalEdgeWall[i] = -1;
+    for (size_t i = 0; i < (size_t)(width + 1) * height; i++) bake->verticalEdgeWall[i] = -1;
+    for (int i = 0; i < pieceCount; i++) {
+        const WallRect* run = &pieces[i].run;
+        for (int k = 0; k < run->length; k++) {
+            if (run->isVertical) {
+                bake->verticalEdgeWall[(size_t)(run->y + k) * (width + 1) + run->x] = i;
+            } else {
+                bake->horizontalEdgeWall[(size_t)run->y * width + run->x + k] = i;
+            }
+        }
+        faces[i] = WallRunFaces(maze, &pieces[i], wallThick, &boxes[i]);
+    }
+
+    // Quads are laid out chunk by chunk in piece order. A 16x16 chunk holds
+    // at most ~2200 quads, well under the 65535-vertex limit of 16-bit indices.
+    for (int c = 0; c < bake->chunkCount; c++) {
+        MazeMeshBakeChunk* chunk = &bake->chunks[c];
+        chunk->firstQuad = bake->quadCount;
+        for (int i = chunk->firstWall; i < chunk->firstWall + chunk->wallCount; i++) {
+            bake->wallChunk[i] = c;
+            chunk->quadCount += FaceCount(faces[i]);
+        }
+        bake->quadCount += chunk->quadCount;
+    }
+
+    size_t quadSlots = bake->quadCount > 0 ? (size_t)bake->quadCount : 1;
+    bake->vertices = (float*)malloc(quadSlots * VERTS_PER_FACE * 3 * sizeof(float));
+    bake->texcoords = (float*)malloc(quadSlots * VERTS_PER_FACE * 2 * sizeof(float));
+    bake->indices = (unsigned short*)malloc(quadSlots * INDICES_PER_FACE * sizeof(unsigned short));
+    bool ok = bake->vertices && bake->texcoords && bake->indices;
+
+    // Emit each chunk through a mesh view of its slice of the arrays
+    for (int c = 0; ok && c < bake->chunkCount; c++) {
+        const MazeMeshBakeChunk* chunk = &bake->chunks[c];
+        Mesh view = {0};
+        view.vertices = &bake->vertices[(size_t)chunk->firstQuad * VERTS_PER_FACE * 3];
+        view.texcoords = &bake->texcoords[(size_t)chunk->firstQuad * VERTS_PER_FACE * 2];
+        view.indices = &bake->indices[(size_t)chunk->firstQuad * INDICES_PER_FACE];
+        int vertCount = 0, indexCount = 0;
+        for (int i = chunk->firstWall; i < chunk->firstWall + chunk->wallCount; i++) {
+            bake->wallFirstIndex[i] = indexCount;
+            bake->wallIndexCount[i] = (unsigned char)(FaceCount(faces[i]) * INDICES_PER_FACE);
+            EmitWallBox(&view, &vertCount, &indexCount, boxes[i], faces[i], wallHeight, maze->cellSize);
+        }
+    }
+
+    free(pieces);
+    free(faces);
+    free(boxes);
+    if (!ok) MazeMesh_FreeBake(bake);
+    return ok;
+}
+
+// Release the arrays of a bake made by MazeMesh_Bake
+void MazeMesh_FreeBake(MazeMeshBake* bake) {
+    if (!bake) return;
+    free(bake->chunks);
+    free(bake->wallChunk);
+    free(bake->wallFirstIndex);
+    free(bake->wallIndexCount);
+    free(bake->horizontalEdgeWall);
+    free(bake->verticalEdgeWall);
+    free(bake->vertices);
+    free(bake->texcoords);
+    free(bake->indices);
+    *bake = (MazeMeshBake){0};
+}
+
+// Send a bake to the GPU: each chunk gets a wall, floor and ceiling model
+// and a bounding box for culling. Wall vertices are uploaded straight from
+// the bake's arrays and the mesh keeps using its lookup tables, so the bake
+// must outlive the mesh (a level pack's mapping does).
+MazeMesh* MazeMesh_Upload(const MazeMeshBake* bake, const Maze* maze, float wallHeight, float wallThick,
+                          Texture2D wallTexture, Texture2D floorTexture, Texture2D ceilingTexture) {
+    if (!bake || !maze || bake->width != maze->width || bake->height != maze->height) return NULL;
+
+    MazeMesh* mesh = (MazeMesh*)calloc(1, sizeof(MazeMesh));
+    if (!mesh) return NULL;
+
+    const int width = maze->width;
+    const int height = maze->height;
+    mesh->width = width;
+    mesh->height = height;
+    mesh->chunksX = ChunkSpan(width);
+    mesh->chunksY = ChunkSpan(height);
+    mesh->chunkCount = bake->chunkCount;
+    mesh->wallCount = bake->pieceCount;
+    mesh->borrowed = true;
+    mesh->wallChunk = bake->wallChunk;
+    mesh->wallFirstIndex = bake->wallFirstIndex;
+    mesh->wallIndexCount = bake->wallIndexCount;
+    mesh->horizontalEdgeWall = bake->horizontalEdgeWall;
+    mesh->verticalEdgeWall = bake->verticalEdgeWall;
+    mesh->chunks = (MazeMeshChunk*)calloc(mesh->chunkCount > 0 ? mesh->chunkCount : 1, sizeof(MazeMeshChunk));
+    mesh->wallStamp = (unsigned int*)calloc(bake->pieceCount > 0 ? bake->pieceCount : 1, sizeof(unsigned int));
+    if (!mesh->chunks || !mesh->wallStamp) {
+        MazeMesh_Destroy(mesh);
+        return NULL;
+    }
+
+    const float originX = -width * 0.5f * maze->cellSize;
+    const float originZ = -height * 0.5f * maze->cellSize;
+    const float halfThick = wallThick * 0.5f;
+
+    for (int c = 0; c < mesh->chunkCount; c++) {
+        MazeMeshChunk* chunk = &mesh->chunks[c];
+        const MazeMeshBakeChunk* range = &bake->chunks[c];
+        int cellX0 = (c % mesh->chunksX) * MAZE_CHUNK_CELLS;
+        int cellY0 = (c / mesh->chunksX) * MAZE_CHUNK_CELLS;
+        int cellX1 = cellX0 + MAZE_CHUNK_CELLS < width ? cellX0 + MAZE_CHUNK_CELLS : width;
+        int cellY1 = cellY0 + MAZE_CHUNK_CELLS < height ? cellY0 + MAZE_CHUNK_CELLS : height;
+        float x0 = originX + cellX0 * maze->cellSize;
+        float z0 = originZ + cellY0 * maze->cellSize;
+        float x1 = originX + cellX1 * maze->cellSize;
+        float z1 = originZ + cellY1 * maze->cellSize;
+
+        chunk->bounds = (BoundingBox){
+            {x0 - halfThick, 0.0f, z0 - halfThick},
+            {x1 + halfThick, wallHeight, z1 + halfThick}
+        };
+        chunk->firstWall = range->firstWall;
+        chunk->wallCount = range->wallCount;
+
+        // Floor and ceiling: one quad each, one texture repeat per full chunk
+        float uSpan = (float)(cellX1 - cellX0) / MAZE_CHUNK_CELLS;
+        float vSpan = (float)(cellY1 - cellY0) / MAZE_CHUNK_CELLS;
+        chunk->floor = FlatModel(x0, z0, x1, z1, 0.0f, true, uSpan, vSpan, floorTexture);
+        chunk->ceiling = FlatModel(x0, z0, x1, z1, wallHeight, false, uSpan, vSpan, ceilingTexture);
+        if (range->quadCount == 0) continue;
+
+        // raylib owns (and frees) a mesh's index list, and culled draws
+        // restore it, so the indices are copied; the vertices are not
+        int indexCount = range->quadCount * INDICES_PER_FACE;
+        Mesh wallMesh = {0};
+        wallMesh.vertexCount = range->quadCount * VERTS_PER_FACE;
+        wallMesh.triangleCount = indexCount / 3;
+        wallMesh.vertices = &bake->vertices[(size_t)range->firstQuad * VERTS_PER_FACE * 3];
+        wallMesh.texcoords = &bake->texcoords[(size_t)range->firstQuad * VERTS_PER_FACE * 2];
+        wallMesh.indices = (unsigned short*)MemAlloc(indexCount * sizeof(unsigned short));
+        chunk->visibleIndices = (unsigned short*)malloc(indexCount * sizeof(unsigned short));
+        if (!wallMesh.indices || !chunk->visibleIndices) {
+            TraceLog(LOG_WARNING, "Out of memory baking chunk %d, its walls are skipped", c);
+            MemFree(wallMesh.indices);
+            free(chunk->visibleIndices);
+            chunk->visibleIndices = NULL;
+            continue;
+        }
+        memcpy(wallMesh.indices, &bake->indices[(size_t)range->firstQuad * INDICES_PER_FACE],
+               indexCount * sizeof(unsigned short));
+        chunk->walls = UploadChunkModel(wallMesh, wallTexture);
+        mesh->faceCount += range->quadCount;
+    }
+    return mesh;
+}
+
+// Bake the maze into fixed-size chunks, each with its own wall, floor and
+// ceiling mesh and a bounding box for culling
+MazeMesh* MazeMesh_Build(const Maze* maze, const WallRect* walls, int wallCount,
+                         float wallHeight, float wallThick,
+                         Texture2D wallTexture, Texture2D floorTexture, Texture2D ceilingTexture) {
+    MazeMeshBake bake;
+    if (!MazeMesh_Bake(maze, walls, wallCount, wallHeight, wallThick, &bake)) return NULL;
+    return MazeMesh_UploadOwned(&bake, maze, wallHeight, wallThick, wallTexture, floorTexture, ceilingTexture);
+}
+
+// Upload a bake made with MazeMesh_Bake and consume it: the mesh takes over
+// the lookup tables and the geometry arrays are freed once on the GPU. The
+// bake is empty afterwards whether or not the upload succeeded.
+MazeMesh* MazeMesh_UploadOwned(MazeMeshBake* bake, const Maze* maze, float wallHeight, float wallThick,
+                               Texture2D wallTexture, Texture2D floorTexture, Texture2D ceilingTexture) {
+    MazeMesh* mesh = MazeMesh_Upload(bake, maze, wallHeight, wallThick, wallTexture, floorTexture, ceilingTexture);
+    if (mesh) {
+        mesh->borrowed = false;
+        bake->wallChunk = NULL;
+        bake->wallFirstIndex = NULL;
+        bake->wallIndexCount = NULL;
+        bake->horizontalEdgeWall = NULL;
+        bake->verticalEdgeWall = NULL;
+    }
+    MazeMesh_FreeBake(bake);
+    return mesh;
+}
+
+// Point every chunk at new textures, e.g. when generated textures replace
+// their placeholders. The models only reference textures, so the old ones
+// stay the caller's to unload.
+void MazeMesh_SetTextures(MazeMesh* mesh, Texture2D wallTexture, Texture2D floorTexture, Texture2D ceilingTexture) {
+    if (!mesh) return;
+    for (int i = 0; mesh->chunks && i < mesh->chunkCount; i++) {
+        MazeMeshChunk* chunk = &mesh->chunks[i];
+        if (chunk->walls.meshCount > 0) chunk->walls.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = wallTexture;
+        if (chunk->floor.meshCount > 0) chunk->floor.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = floorTexture;
+        if (chunk->ceiling.meshCount > 0) {
+            chunk->ceiling.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = ceilingTexture;
+        }
+    }
+}
+
+// Draw every chunk with one shader instead of the default textured one.
+// The shader stays the caller's; UnloadModel leaves material shaders alone.
+void MazeMesh_SetShader(MazeMesh* mesh, Shader shader) {
+    if (!mesh) return;
+    for (int i = 0; mesh->chunks && i < mesh->chunkCount; i++) {
+        MazeMeshChunk* chunk = &mesh->chunks[i];
+        if (chunk->walls.meshCount > 0) chunk->walls.materials[0].shader = shader;
+        if (chunk->floor.meshCount > 0) chunk->floor.materials[0].shader = shader;
+        if (chunk->ceiling.meshCount > 0) chunk->ceiling.materials[0].shader = shader;
+    }
+}
+
+// Unload GPU buffers and free the mesh
+void MazeMesh_Destroy(MazeMesh* mesh) {
+    if (!mesh) return;
+    for (int i = 0; mesh->chunks && i < mesh->chunkCount; i++) {
+        if (mesh->chunks[i].walls.meshCount > 0) UnloadModel(mesh->chunks[i].walls);
+        if (mesh->chunks[i].floor.meshCount > 0) UnloadModel(mesh->chunks[i].floor);
+        if (mesh->chunks[i].ceiling.meshCount > 0) UnloadModel(mesh->chunks[i].ceiling);
+        free(mesh->chunks[i].visibleIndices);
+    }
+    if (!mesh->borrowed) {
+        free(mesh->wallChunk);
+        free(mesh->wallFirstIndex);
+        free(mesh->wallIndexCount);
+        free(mesh->horizontalEdgeWall);
+        free(mesh->verticalEdgeWall);
+    }
+    free(mesh->chunks);
+    free(mesh->wallStamp);
+    free(mesh);
+}
+
+// Helper: Put the full index list back after a culled draw
+static void RestoreChunk(MazeMeshChunk* chunk) {
+    if (!chunk->partial) return;
+    Mesh* m = &chunk->walls.meshes[0];
+    UpdateMeshBuffer(*m, MESH_BUFFER_INDICES, m->indices, m->triangleCount * 3 * (int)sizeof(unsigned short), 0);
+    chunk->partial = false;
+}
+
+// Helper: Flag a chunk as holding visible geometry this frame
+static void TouchChunk(MazeMesh* mesh, int chunkIndex) {
+    MazeMeshChunk* chunk = &mesh->chunks[chunkIndex];
+    if (chunk->visibleStamp == mesh->frame) return;
+    chunk->visibleStamp = mesh->frame;
+    chunk->visibleIndexCount = 0;
+}
+
+// Helper: Queue the indices of the wall piece on one lattice edge
+static void GatherWall(MazeMesh* mesh, int wall) {
+    if (wall < 0 || mesh->wallStamp[wall] == mesh->frame) return;
+    mesh->wallStamp[wall] = mesh->frame;
+
+    TouchChunk(mesh, mesh->wallChunk[wall]);
+    MazeMeshChunk* chunk = &mesh->chunks[mesh->wallChunk[wall]];
+    if (mesh->wallIndexCount[wall] == 0 || chunk->walls.meshCount == 0) return;
+    const unsigned short* src = &chunk->walls.meshes[0].indices[mesh->wallFirstIndex[wall]];
+    memcpy(&chunk->visibleIndices[chunk->visibleIndexCount], src, mesh->wallIndexCount[wall] * sizeof(unsigned short));
+    chunk->visibleIndexCount += mesh->wallIndexCount[wall];
+}
+
+// Draw the chunks inside the frustum. With a visible set, only chunks holding
+// visible cells are drawn and their walls are cut down to the pieces
+// bordering those cells (a compacted index upload, still one draw call).
+void MazeMesh_Draw(MazeMesh* mesh, const Frustum* frustum, const VisibleSet* visible) {
+    if (!mesh) return;
+
+    mesh->frame++;
+    if (mesh->frame == 0) {
+        memset(mesh->wallStamp, 0, (mesh->wallCount > 0 ? mesh->wallCount : 1) * sizeof(unsigned int));
+        for (int i = 0; i < mesh->chunkCount; i++) mesh->chunks[i].visibleStamp = 0;
+        mesh->frame = 1;
+    }
+
+    if (visible) {
+        const int width = mesh->width;
+        for (int i = 0; i < visible->count; i++) {
+            int x = visible->cells[i] % width;
+            int y = visible->cells[i] / width;
+            TouchChunk(mesh, (y / MAZE_CHUNK_CELLS) * mesh->chunksX + x / MAZE_CHUNK_CELLS);
+            GatherWall(mesh, mesh->horizontalEdgeWall[(size_t)y * width + x]);
+            GatherWall(mesh, mesh->horizontalEdgeWall[(size_t)(y + 1) * width + x]);
+            GatherWall(mesh, mesh->verticalEdgeWall[(size_t)y * (width + 1) + x]);
+            GatherWall(mesh, mesh->verticalEdgeWall[(size_t)y * (width + 1) + x + 1]);
+        }
+    }
+
+    mesh->drawCalls = 0;
+    mesh->drawnFaces = 0;
+    mesh->drawnChunks = 0;
+    for (int i = 0; i < mesh->chunkCount; i++) {
+        MazeMeshChunk* chunk = &mesh->chunks[i];
+        if (visible && chunk->visibleStamp != mesh->frame) continue;
+        if (!Frustum_ContainsBox(frustum, chunk->bounds)) continue;
+        mesh->drawnChunks++;
+
+        if (chunk->floor.meshCount > 0) {
+            DrawModel(chunk->floor, (Vector3){0, 0, 0}, 1.0f, WHITE);
+            mesh->drawCalls++;
+        }
+        if (chunk->ceiling.meshCount > 0) {
+            DrawModel(chunk->ceiling, (Vector3){0, 0, 0}, 1.0f, WHITE);
+            mesh->drawCalls++;
+        }
+        if (chunk->walls.meshCount == 0) continue;
+
+        if (!visible) {
+            RestoreChunk(chunk);
+            DrawModel(chunk->walls, (Vector3){0, 0, 0}, 1.0f, WHITE);
+            mesh->drawCalls++;
+            mesh->drawnFaces += chunk->walls.meshes[0].triangleCount / 2;
+            continue;
+        }
+        if (chunk->visibleIndexCount == 0) continue;
+
+        Mesh culled = chunk->walls.meshes[0];
+        UpdateMeshBuffer(culled, MESH_BUFFER_INDICES, chunk->visibleIndices,
+                         chunk->visibleIndexCount * (int)sizeof(unsigned short), 0);
+        culled.triangleCount = chunk->visibleIndexCount / 3;
+        chunk->partial = true;
+
+        DrawMesh(culled, chunk->walls.materials[0], chunk->walls.transform);
+        mesh->drawCalls++;
+        mesh->drawnFaces += chunk->visibleIndexCount / INDICES_PER_FACE;
+    }
+}
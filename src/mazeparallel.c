@@ -0,0 +1,222 @@
+#define _POSIX_C_SOURCE 200809L
+#include "../include/maze.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// Work shared by the tile workers
+typedef struct {
+    Maze* maze;
+    MazeAlgorithm algorithm;
+    uint64_t seed;          // Base seed; tile i uses stream (seed, MAZE, i)
+    int tileSize;
+    int tilesX, tilesY;
+    atomic_int nextTile;
+    atomic_bool failed;
+} TileJob;
+
+// Helper: Union-find root with path halving
+static uint32_t FindRoot(uint32_t* parent, uint32_t i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+// Helper: Worker loop. Tiles are claimed from a shared counter, carved into a
+// private buffer and copied into their rows of the maze, so no two threads
+// ever write the same bytes (packed tiles start on a multiple of 4 cells).
+static void* TileWorker(void* arg) {
+    TileJob* job = (TileJob*)arg;
+    Maze* maze = job->maze;
+    unsigned char* buffer = (unsigned char*)malloc((size_t)job->tileSize * job->tileSize);
+    if (!buffer) {
+        atomic_store(&job->failed, true);
+        return NULL;
+    }
+
+    const int tileCount = job->tilesX * job->tilesY;
+    for (int tile = atomic_fetch_add(&job->nextTile, 1); tile < tileCount;
+         tile = atomic_fetch_add(&job->nextTile, 1)) {
+        int x0 = (tile % job->tilesX) * job->tileSize;
+        int y0 = (tile / job->tilesX) * job->tileSize;
+        int w = maze->width - x0 < job->tileSize ? maze->width - x0 : job->tileSize;
+        int h = maze->height - y0 < job->tileSize ? maze->height - y0 : job->tileSize;
+
+        Maze local = {0};
+        local.width = w;
+        local.height = h;
+        local.cells = buffer;
+        local.cellSize = 1.0f;
+        Rng rng = Rng_ForStream(job->seed, RNG_STREAM_MAZE, (uint64_t)tile);
+        if (!Maze_GenerateWith(&local, job->algorithm, &rng)) {
+            atomic_store(&job->failed, true);
+            break;
+        }
+
+        for (int y = 0; y < h; y++) {
+            Maze_SetRow(maze, y0 + y, x0, w, &buffer[(size_t)y * w]);
+        }
+    }
+
+    free(buffer);
+    return NULL;
+}
+
+// Helper: Join the tiles into one perfect maze. Tile adjacencies are taken
+// in random order and a door is opened only between tiles not yet connected
+// (Kruskal on the tile graph), so exactly tiles - 1 doors are added.
+static bool StitchTiles(Maze* maze, int tileSize, int tilesX, int tilesY, Rng* rng) {
+    const int tileCount = tilesX * tilesY;
+    const int eastLinks = (tilesX - 1) * tilesY;
+    const int linkCount = eastLinks + tilesX * (tilesY - 1);
+
+    uint32_t* parent = (uint32_t*)malloc((size_t)tileCount * sizeof(uint32_t));
+    int* links = (int*)malloc((size_t)(linkCount > 0 ? linkCount : 1) * sizeof(int));
+    if (!parent || !links) {
+        free(parent);
+        free(links);
+        return false;
+    }
+    for (int i = 0; i < tileCount; i++) parent[i] = (uint32_t)i;
+    for (int i = 0; i < linkCount; i++) links[i] = i;
+
+    for (int i = 0; i < linkCount; i++) {
+        int j = i + (int)Rng_Range(rng, (uint32_t)(linkCount - i));
+        int link = links[j];
+        links[j] = links[i];
+
+        int a, b;
+        bool east = link < eastLinks;
+        if (east) {
+            a = (link / (tilesX - 1)) * tilesX + link % (tilesX - 1);
+            b = a + 1;
+        } else {
+            a = link - eastLinks;
+            b = a + tilesX;
+        }
+
+        uint32_t ra = FindRoot(parent, (uint32_t)a);
+        uint32_t rb = FindRoot(parent, (uint32_t)b);
+        if (ra == rb) continue;
+        parent[rb] = ra;
+
+        // Door at a random offset along the shared border
+        int x0 = (a % tilesX) * tileSize;
+        int y0 = (a / tilesX) * tileSize;
+        if (east) {
+            int h = maze->height - y0 < tileSize ? maze->height - y0 : tileSize;
+            int y = y0 + (int)Rng_Range(rng, (uint32_t)h);
+            Maze_RemoveWall(maze, x0 + tileSize - 1, y, MAZE_EAST);
+        } else {
+            int w = maze->width - x0 < tileSize ? maze->width - x0 : tileSize;
+            int x = x0 + (int)Rng_Range(rng, (uint32_t)w);
+            Maze_RemoveWall(maze, x, y0 + tileSize - 1, MAZE_SOUTH);
+        }
+    }
+
+    free(parent);
+    free(links);
+    return true;
+}
+
+// Number of hardware threads (at least 1)
+int Maze_HardwareThreads(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+// Generate a perfect maze by carving square tiles in parallel and stitching
+// them together. The result depends only on the rng state and tile size, not
+// on the thread count.
+bool Maze_GenerateParallel(Maze* maze, MazeAlgorithm algorithm, Rng* rng, int threadCount, int tileSize) {
+    if (!maze || (!maze->cells && !maze->edges) || !rng || tileSize < 1) return false;
+    if (threadCount < 1) threadCount = Maze_HardwareThreads();
+    if (maze->edges) tileSize = (tileSize + 3) & ~3;    // Packed tiles must not share bytes
+
+    TileJob job;
+    job.maze = maze;
+    job.algorithm = algorithm;
+    job.seed = ((uint64_t)Rng_Next(rng) << 32) | Rng_Next(rng);
+    job.tileSize = tileSize;
+    job.tilesX = (maze->width + tileSize - 1) / tileSize;
+    job.tilesY = (maze->height + tileSize - 1) / tileSize;
+    atomic_init(&job.nextTile, 0);
+    atomic_init(&job.failed, false);
+
+    int tileCount = job.tilesX * job.tilesY;
+    if (threadCount > tileCount) threadCount = tileCount;
+
+    // The calling thread works too
+    pthread_t* threads = (pthread_t*)malloc((size_t)threadCount * sizeof(pthread_t));
+    int started = 0;
+    if (threads) {
+        for (; started < threadCount - 1; started++) {
+            if (pthread_create(&threads[started], NULL, TileWorker, &job) != 0) break;
+        }
+    }
+    TileWorker(&job);
+    for (int i = 0; i < started; i++) pthread_join(threads[i], NULL);
+    free(threads);
+
+    if (atomic_load(&job.failed) || !StitchTiles(maze, tileSize, job.tilesX, job.tilesY, rng)) {
+        TraceLog(LOG_ERROR, "Out of memory generating %dx%d maze in tiles", maze->width, maze->height);
+        Maze_Reset(maze);
+        return false;
+    }
+    return true;
+}
+
+// Validate that the open passages form a spanning tree: exactly cells - 1
+// of them and no cycle (union-find over the cells)
+bool Maze_IsPerfect(const Maze* maze) {
+    if (!maze) return false;
+
+    const size_t cellCount = (size_t)maze->width * maze->height;
+    if (cellCount > UINT32_MAX) return false;
+    uint32_t* parent = (uint32_t*)malloc(cellCount * sizeof(uint32_t));
+    if (!parent) return false;
+    for (size_t i = 0; i < cellCount; i++) parent[i] = (uint32_t)i;
+
+    size_t passages = 0;
+    bool perfect = true;
+    for (int y = 0; y < maze->height && perfect; y++) {
+        for (int x = 0; x < maze->width && perfect; x++) {
+            uint32_t i = (uint32_t)((size_t)y * maze->width + x);
+            unsigned char cell = Maze_GetCell(maze, x, y);
+
+            // Border walls must stay closed, and each passage must agree
+            // with the neighbour's side of it
+            if ((x == 0 && !(cell & MAZE_WEST)) || (y == 0 && !(cell & MAZE_NORTH)) ||
+                (x == maze->width - 1 && !(cell & MAZE_EAST)) || (y == maze->height - 1 && !(cell & MAZE_SOUTH))) {
+                perfect = false;
+                break;
+            }
+            for (int k = 0; k < 2; k++) {
+                int dir = k == 0 ? MAZE_EAST : MAZE_SOUTH;
+                if (cell & dir) continue;
+                int nx = x + (k == 0 ? 1 : 0);
+                int ny = y + (k == 0 ? 0 : 1);
+                if (Maze_HasWall(maze, nx, ny, k == 0 ? MAZE_WEST : MAZE_NORTH)) {
+                    perfect = false;
+                    break;
+                }
+
+                uint32_t ra = FindRoot(parent, i);
+                uint32_t rb = FindRoot(parent, (uint32_t)((size_t)ny * maze->width + nx));
+                if (ra == rb) {
+                    perfect = false;    // Cycle
+                    break;
+                }
+                parent[rb] = ra;
+                passages++;
+            }
+        }
+    }
+
+    free(parent);
+    return perfect && passages == cellCount - 1;
+}
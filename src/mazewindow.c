@@ -0,0 +1,227 @@
+#define _POSIX_C_SOURCE 200809L
+#include "../include/mazewindow.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// One mapped band of rows
+typedef struct {
+    int band;                   // Band index (-1 while unused)
+    uint64_t lastUse;
+    void* view;                 // Mapping (page aligned) or heap copy
+    size_t viewSize;
+    const unsigned char* rows;  // First row of the band inside view
+} WindowBand;
+
+// Windowed backend: the maze file stays on disk and only a few bands of
+// rows are mapped at a time, least recently used band replaced first
+typedef struct {
+#ifdef _WIN32
+    FILE* file;
+#else
+    int fd;
+#endif
+    int width, height;
+    bool packed;
+    size_t stride;              // Bytes per row
+    uint64_t payloadOffset;
+    int bandRows;
+    WindowBand bands[MAZE_WINDOW_BANDS];
+    int last;                   // Most recent hit, checked first
+    uint64_t tick;
+    MazeWindowStats stats;
+} MazeWindowState;
+
+// Helper: Release one band
+static void UnmapBand(WindowBand* band) {
+    if (!band->view) return;
+#ifdef _WIN32
+    free(band->view);
+#else
+    munmap(band->view, band->viewSize);
+#endif
+    band->view = NULL;
+    band->rows = NULL;
+    band->band = -1;
+}
+
+// Helper: Map band b of the payload into a slot
+static bool MapBand(MazeWindowState* window, WindowBand* slot, int b) {
+    int firstRow = b * window->bandRows;
+    int rows = window->height - firstRow < window->bandRows ? window->height - firstRow : window->bandRows;
+    uint64_t start = window->payloadOffset + (uint64_t)firstRow * window->stride;
+    size_t length = (size_t)rows * window->stride;
+
+#ifdef _WIN32
+    slot->view = malloc(length);
+    if (!slot->view || _fseeki64(window->file, (long long)start, SEEK_SET) != 0 ||
+        fread(slot->view, 1, length, window->file) != length) {
+        free(slot->view);
+        slot->view = NULL;
+        return false;
+    }
+    slot->viewSize = length;
+    slot->rows = (const unsigned char*)slot->view;
+#else
+    // Mappings start on a page boundary
+    uint64_t page = (uint64_t)sysconf(_SC_PAGESIZE);
+    uint64_t aligned = start - start % page;
+    slot->viewSize = length + (size_t)(start - aligned);
+    slot->view = mmap(NULL, slot->viewSize, PROT_READ, MAP_PRIVATE, window->fd, (off_t)aligned);
+    if (slot->view == MAP_FAILED) {
+        slot->view = NULL;
+        return false;
+    }
+    slot->rows = (const unsigned char*)slot->view + (start - aligned);
+#endif
+    slot->band = b;
+    return true;
+}
+
+// Helper: Row y of the payload, mapping its band on a miss
+static const unsigned char* AcquireRow(MazeWindowState* window, int y) {
+    window->tick++;
+    window->stats.lookups++;
+    int b = y / window->bandRows;
+
+    WindowBand* slot = &window->bands[window->last];
+    if (slot->band != b) {
+        int found = -1;
+        int victim = 0;
+        for (int i = 0; i < MAZE_WINDOW_BANDS; i++) {
+            if (window->bands[i].band == b) found = i;
+            if (window->bands[i].lastUse < window->bands[victim].lastUse) victim = i;
+        }
+        if (found < 0) {
+            found = victim;
+            UnmapBand(&window->bands[found]);
+            if (!MapBand(window, &window->bands[found], b)) {
+                TraceLog(LOG_ERROR, "Failed to map maze rows %d-%d", b * window->bandRows,
+                         (b + 1) * window->bandRows - 1);
+                return NULL;
+            }
+            window->stats.remaps++;
+        }
+        window->last = found;
+        slot = &window->bands[found];
+    }
+    slot->lastUse = window->tick;
+    return slot->rows + (size_t)(y - b * window->bandRows) * window->stride;
+}
+
+// Helper: MazeSource callback
+static unsigned char WindowGetCell(void* user, int x, int y) {
+    MazeWindowState* window = (MazeWindowState*)user;
+    const unsigned char* row = AcquireRow(window, y);
+    if (!row) return MAZE_ALL;
+    if (!window->packed) return row[x];
+
+    // Packed: own north/west edges, east/south from the neighbours
+    unsigned int own = (row[x >> 2] >> ((x & 3) * 2)) & 3u;
+    unsigned char cell = 0;
+    if (own & MAZE_PACKED_NORTH) cell |= MAZE_NORTH;
+    if (own & MAZE_PACKED_WEST) cell |= MAZE_WEST;
+    if (x + 1 == window->width || ((row[(x + 1) >> 2] >> (((x + 1) & 3) * 2)) & MAZE_PACKED_WEST)) cell |= MAZE_EAST;
+    if (y + 1 == window->height) {
+        cell |= MAZE_SOUTH;
+    } else {
+        const unsigned char* below = AcquireRow(window, y + 1);
+        if (!below || ((below[x >> 2] >> ((x & 3) * 2)) & MAZE_PACKED_NORTH)) cell |= MAZE_SOUTH;
+    }
+    return cell;
+}
+
+// Helper: MazeSource callback
+static void WindowDestroy(void* user) {
+    MazeWindowState* window = (MazeWindowState*)user;
+    if (!window) return;
+    for (int i = 0; i < MAZE_WINDOW_BANDS; i++) UnmapBand(&window->bands[i]);
+#ifdef _WIN32
+    if (window->file) fclose(window->file);
+#else
+    if (window->fd >= 0) close(window->fd);
+#endif
+    free(window);
+}
+
+// Open a row-major (bytes or packed) maze file of any size with at most
+// about windowBytes of it mapped at once. Queries page bands of rows in and
+// out on demand, so mazes far larger than memory can be walked and
+// collided against through the usual Maze_* queries.
+Maze* MazeWindow_Map(const char* path, size_t windowBytes) {
+    MazeFileHeader header;
+    if (!Maze_ReadFileHeader(path, &header)) {
+        TraceLog(LOG_WARNING, "Could not open maze file %s", path ? path : "(null)");
+        return NULL;
+    }
+    if (header.storage != MAZE_STORAGE_BYTES && header.storage != MAZE_STORAGE_PACKED) {
+        TraceLog(LOG_WARNING, "%s: only row-major maze files can be windowed", path);
+        return NULL;
+    }
+
+    MazeWindowState* window = (MazeWindowState*)calloc(1, sizeof(MazeWindowState));
+    if (!window) return NULL;
+    window->width = (int)header.width;
+    window->height = (int)header.height;
+    window->packed = header.storage == MAZE_STORAGE_PACKED;
+    window->stride = window->packed ? MAZE_PACKED_STRIDE(header.width) : header.width;
+    window->payloadOffset = header.payloadOffset;
+    for (int i = 0; i < MAZE_WINDOW_BANDS; i++) window->bands[i].band = -1;
+
+    // Split the budget between the bands (at least one row each)
+    size_t rows = windowBytes / MAZE_WINDOW_BANDS / window->stride;
+    if (rows < 1) rows = 1;
+    if (rows > header.height) rows = header.height;
+    window->bandRows = (int)rows;
+    window->stats.bandRows = window->bandRows;
+    window->stats.bandBytes = rows * window->stride;
+
+#ifdef _WIN32
+    window->file = fopen(path, "rb");
+    bool opened = window->file != NULL;
+#else
+    window->fd = open(path, O_RDONLY);
+    bool opened = window->fd >= 0;
+#endif
+    if (!opened) {
+        TraceLog(LOG_WARNING, "Could not open maze file %s", path);
+#ifndef _WIN32
+        window->fd = -1;
+#endif
+        WindowDestroy(window);
+        return NULL;
+    }
+
+    MazeSource source = {WindowGetCell, WindowDestroy, window, NULL};
+    Maze* maze = Maze_CreateWithSource(window->width, window->height, header.cellSize, source);
+    if (!maze) {
+        WindowDestroy(window);
+        return NULL;
+    }
+    maze->startPos = (Vector2){header.startX, header.startY};
+    maze->exitPos = (Vector2){header.exitX, header.exitY};
+    maze->seed = header.seed;
+    return maze;
+}
+
+// Check whether a maze is served through a file window
+bool MazeWindow_Is(const Maze* maze) {
+    return maze && !maze->cells && !maze->edges && maze->source.getCell == WindowGetCell;
+}
+
+// Paging counters (all zero for other mazes)
+MazeWindowStats MazeWindow_GetStats(const Maze* maze) {
+    MazeWindowStats stats = {0};
+    if (MazeWindow_Is(maze)) {
+        const MazeWindowState* window = (const MazeWindowState*)maze->source.user;
+        stats = window->stats;
+        for (int i = 0; i < MAZE_WINDOW_BANDS; i++) stats.resident += window->bands[i].band >= 0;
+    }
+    return stats;
+}
@@ -0,0 +1,130 @@
+#include "../include/procmaterial.h"
+#include "../include/assets.h"
+#include "../include/mazemesh.h"
+
+#define STRINGIFY_(x) #x
+#define STRINGIFY(x) STRINGIFY_(x)
+
+// World position for the fragment shader; nothing else is interpolated
+static const char* const s_vertexShader =
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "uniform mat4 mvp;\n"
+    "uniform mat4 matModel;\n"
+    "out vec3 worldPos;\n"
+    "void main() {\n"
+    "    worldPos = (matModel * vec4(vertexPosition, 1.0)).xyz;\n"
+    "    gl_Position = mvp * vec4(vertexPosition, 1.0);\n"
+    "}\n";
+
+// The ProcTex_Fill patterns with its coordinate hash, over world space
+// instead of a wrapping tile. Tiles keep the textures' scale: one per cell
+// by the wall height on walls, one per chunk on floors and ceilings, and
+// speckle at ASSET_TEXTURE_SIZE texels per tile. Surfaces are told apart
+// by the face normal; mortar, seams and speckle are filtered by the pixel
+// footprint since there are no mips.
+static const char* const s_fragmentShader =
+    "#version 330\n"
+    "#define TEXELS " STRINGIFY(ASSET_TEXTURE_SIZE) ".0\n"
+    "#define FLOOR_TILE_CELLS " STRINGIFY(MAZE_CHUNK_CELLS) ".0\n"
+    "in vec3 worldPos;\n"
+    "uniform vec4 colDiffuse;\n"
+    "uniform float cellSize;\n"
+    "uniform float wallHeight;\n"
+    "uniform int seed;\n"
+    "out vec4 finalColor;\n"
+    "uint Mix(uint h) {\n"
+    "    h ^= h >> 16; h *= 0x7feb352du; h ^= h >> 15; h *= 0x846ca68bu; h ^= h >> 16;\n"
+    "    return h;\n"
+    "}\n"
+    "float Hash(vec2 p, uint s) {\n"
+    "    ivec2 c = ivec2(floor(p));\n"
+    "    return float(Mix(uint(c.x) * 0x8da6b343u + uint(c.y) * 0xd8163841u + s) >> 8) * (1.0 / 16777216.0);\n"
+    "}\n"
+    "float Noise(vec2 p, uint s) {\n"
+    "    vec2 i = floor(p);\n"
+    "    vec2 f = p - i;\n"
+    "    f = f * f * (3.0 - 2.0 * f);\n"
+    "    float a = Hash(i, s), b = Hash(i + vec2(1.0, 0.0), s);\n"
+    "    float c = Hash(i + vec2(0.0, 1.0), s), d = Hash(i + vec2(1.0, 1.0), s);\n"
+    "    return mix(mix(a, b, f.x), mix(c, d, f.x), f.y);\n"
+    "}\n"
+    "float Speckle(vec2 texel, uint s) {\n"
+    "    vec2 fw = fwidth(texel);\n"
+    "    return mix(Hash(texel, s), 0.5, clamp(max(fw.x, fw.y) - 1.0, 0.0, 1.0));\n"
+    "}\n"
+    "float Line(float p, float width) {\n"
+    "    float d = abs(fract(p - width * 0.5 + 0.5) - 0.5);\n"
+    "    return clamp((width * 0.5 - d) / max(fwidth(p), 1e-4) + 0.5, 0.0, 1.0);\n"
+    "}\n"
+    "vec3 Stone(vec2 uv, uint s) {\n"
+    "    vec2 block = uv * 8.0;\n"
+    "    float n = Noise(block * 4.0, Mix(s + 0xDAA66D2Bu)) * 0.105 + Hash(block, Mix(s + 0x3C6EF372u)) * 0.135 +\n"
+    "              Speckle(uv * TEXELS, Mix(s + 0x9E3779B9u)) * 0.06;\n"
+    "    vec3 stone = vec3(80.0, 80.0, 85.0) + n * vec3(40.0, 30.0, 25.0);\n"
+    "    float mortar = max(Line(block.x, 1.0 / 16.0), Line(block.y, 1.0 / 16.0));\n"
+    "    return mix(stone, vec3(50.0, 50.0, 55.0), mortar) / 255.0;\n"
+    "}\n"
+    "vec3 Wood(vec2 uv, uint s) {\n"
+    "    float plank = floor(uv.y * 4.0);\n"
+    "    float g = Noise(uv * vec2(4.0, 64.0), Mix(s + 0xDAA66D2Bu)) * 0.12 + sin(uv.x * 25.1327412 + plank * 0.5) * 0.1 +\n"
+    "              Speckle(uv * TEXELS, Mix(s + 0x9E3779B9u)) * 0.08;\n"
+    "    vec3 wood = vec3(120.0, 90.0, 60.0) + g * vec3(40.0, 30.0, 20.0);\n"
+    "    return wood * (1.0 - 0.3 * Line(uv.y * 4.0, 1.0 / 32.0)) / 255.0;\n"
+    "}\n"
+    "vec3 Ceiling(vec2 uv, uint s) {\n"
+    "    float n = Noise(uv * 8.0, Mix(s + 0xDAA66D2Bu)) * 0.09 + Speckle(uv * TEXELS, Mix(s + 0x9E3779B9u)) * 0.06;\n"
+    "    return (vec3(150.0, 150.0, 155.0) + n * 20.0) / 255.0;\n"
+    "}\n"
+    "void main() {\n"
+    "    vec3 n = abs(cross(dFdx(worldPos), dFdy(worldPos)));\n"
+    "    uint s = uint(seed);\n"
+    "    vec3 color;\n"
+    "    if (n.y > max(n.x, n.z)) {\n"
+    "        vec2 uv = worldPos.xz / (cellSize * FLOOR_TILE_CELLS);\n"
+    "        color = worldPos.y < wallHeight * 0.5 ? Wood(uv, Mix(s + 1u)) : Ceiling(uv, Mix(s + 2u));\n"
+    "    } else {\n"
+    "        bool alongZ = n.x > n.z;\n"
+    "        vec2 uv = vec2((alongZ ? worldPos.z : worldPos.x) / cellSize, 1.0 - worldPos.y / wallHeight);\n"
+    "        float depth = alongZ ? worldPos.x : worldPos.z;\n"
+    "        color = Stone(uv, Mix(s ^ uint(int(round(depth * 16.0)))));\n"
+    "    }\n"
+    "    finalColor = vec4(color, 1.0) * colDiffuse;\n"
+    "}\n";
+
+// Compile the material shader. False if the GPU rejects it (raylib then
+// hands back its default shader, which has none of our uniforms), in which
+// case the caller should fall back to textures.
+bool ProcMaterial_Load(ProcMaterial* material, uint32_t seed) {
+    if (!material) return false;
+    *material = (ProcMaterial){0};
+
+    Shader shader = LoadShaderFromMemory(s_vertexShader, s_fragmentShader);
+    int wallHeightLoc = shader.id > 0 ? GetShaderLocation(shader, "wallHeight") : -1;
+    if (wallHeightLoc < 0) {
+        UnloadShader(shader);
+        return false;
+    }
+
+    material->shader = shader;
+    material->cellSizeLoc = GetShaderLocation(shader, "cellSize");
+    material->wallHeightLoc = wallHeightLoc;
+    material->seedLoc = GetShaderLocation(shader, "seed");
+    int seedValue = (int)(seed & 0x7FFFFFFFu);
+    SetShaderValue(shader, material->seedLoc, &seedValue, SHADER_UNIFORM_INT);
+    return true;
+}
+
+// Set the level's dimensions; uniforms stay on the program, so this is
+// needed once per level rather than per frame
+void ProcMaterial_SetScale(const ProcMaterial* material, float cellSize, float wallHeight) {
+    if (!material || material->shader.id == 0) return;
+    SetShaderValue(material->shader, material->cellSizeLoc, &cellSize, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(material->shader, material->wallHeightLoc, &wallHeight, SHADER_UNIFORM_FLOAT);
+}
+
+void ProcMaterial_Unload(ProcMaterial* material) {
+    if (!material || material->shader.id == 0) return;
+    UnloadShader(material->shader);
+    *material = (ProcMaterial){0};
+}
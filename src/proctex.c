@@ -0,0 +1,388 @@
+#include "../include/proctex.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+// SSE2 row kernels; PROCTEX_NO_SIMD forces the scalar ones, which produce
+// the same pixels
+#if defined(__SSE2__) && !defined(PROCTEX_NO_SIMD)
+#include <emmintrin.h>
+#define PROCTEX_SIMD 1
+#else
+#define PROCTEX_SIMD 0
+#endif
+
+// Coordinate hash: lattice coordinates are spread by two odd constants and
+// finished with a lowbias32 mix, so every pixel's value depends only on
+// (x, y, seed) and any pixel can be computed alone, in any order
+#define HASH_X  0x8da6b343u
+#define HASH_Y  0xd8163841u
+#define HASH_M1 0x7feb352du
+#define HASH_M2 0x846ca68bu
+
+#define NOISE_MAX_CELLS 64      // Lattice columns per noise row (bounds the row table)
+
+// One octave of value noise: a lattice of (1 << shiftX) x (1 << shiftY)
+// pixel cells that wraps at the texture edges, so power-of-two textures tile
+typedef struct {
+    uint32_t seed;
+    int shiftX, shiftY;
+    uint32_t maskX, maskY;      // Lattice cells across/down minus one
+    float invX, invY;           // 1 / cell size
+} NoiseLayer;
+
+// Work shared by the band workers
+typedef struct {
+    ProcTexPattern pattern;
+    Color* pixels;
+    int width, height;
+    NoiseLayer noise;
+    const int* cell0;           // Per column: lattice column left of the pixel
+    const int* cell1;           // Per column: lattice column right of it
+    const float* weightX;       // Per column: smoothed horizontal weight
+    uint32_t speckleSeed;       // Per-pixel speckle
+    uint32_t blockSeed;         // Stone: one tone per block
+    int blockShiftX, blockShiftY;
+    int mortarX, mortarY;       // Stone: mortar line widths
+    int plankShift, planks;     // Wood: plank rows as a shift, plank count
+    int seamRows;
+    const float* grain;         // Wood: sine grain per plank and column
+    float* scratch;             // One row of floats per worker
+    atomic_int nextSlot;
+    int bandCount;
+    atomic_int nextBand;
+} TexJob;
+
+// Helper: floor(log2(v)) for v >= 1
+static int FloorLog2(int v) {
+    int shift = 0;
+    while ((2 << shift) <= v) shift++;
+    return shift;
+}
+
+// Helper: Finish a hash (lowbias32)
+static inline uint32_t Mix(uint32_t h) {
+    h ^= h >> 16;
+    h *= HASH_M1;
+    h ^= h >> 15;
+    h *= HASH_M2;
+    h ^= h >> 16;
+    return h;
+}
+
+// Helper: Top 24 bits of a hash as a float in [0, 1)
+static inline float Unit(uint32_t h) {
+    return (float)(h >> 8) * (1.0f / 16777216.0f);
+}
+
+// Helper: Smoothstep weight
+static inline float Smooth(float f) {
+    return f * f * (3.0f - 2.0f * f);
+}
+
+// Helper: Noise layer with cells of 2^shiftX x 2^shiftY pixels
+static NoiseLayer MakeLayer(uint32_t seed, int shiftX, int shiftY, int sizeShiftX, int sizeShiftY) {
+    if (shiftX > sizeShiftX) shiftX = sizeShiftX;
+    if (shiftY > sizeShiftY) shiftY = sizeShiftY;
+    if (shiftX < 0) shiftX = 0;
+    if (shiftY < 0) shiftY = 0;
+    while ((1 << (sizeShiftX - shiftX)) > NOISE_MAX_CELLS) shiftX++;
+
+    NoiseLayer layer;
+    layer.seed = seed;
+    layer.shiftX = shiftX;
+    layer.shiftY = shiftY;
+    layer.maskX = (1u << (sizeShiftX - shiftX)) - 1;
+    layer.maskY = (1u << (sizeShiftY - shiftY)) - 1;
+    layer.invX = 1.0f / (float)(1 << shiftX);
+    layer.invY = 1.0f / (float)(1 << shiftY);
+    return layer;
+}
+
+// Helper: Value noise for one row, times scale. The lattice is blended
+// vertically once per lattice column, then each pixel only interpolates
+// between two of those using the per-column tables.
+static void NoiseRow(const TexJob* job, int y, float scale, float* out) {
+    const NoiseLayer* layer = &job->noise;
+    uint32_t cy = (uint32_t)y >> layer->shiftY;
+    float wy = Smooth((float)((uint32_t)y & ((1u << layer->shiftY) - 1)) * layer->invY);
+    uint32_t y0 = (cy & layer->maskY) * HASH_Y + layer->seed;
+    uint32_t y1 = ((cy + 1) & layer->maskY) * HASH_Y + layer->seed;
+
+    float column[NOISE_MAX_CELLS];
+    for (uint32_t c = 0; c <= layer->maskX; c++) {
+        float above = Unit(Mix(c * HASH_X + y0));
+        float below = Unit(Mix(c * HASH_X + y1));
+        column[c] = above + (below - above) * wy;
+    }
+    for (int x = 0; x < job->width; x++) {
+        float left = column[job->cell0[x]];
+        out[x] = (left + (column[job->cell1[x]] - left) * job->weightX[x]) * scale;
+    }
+}
+
+// Helper: Per-pixel speckle in [0, 1)
+static inline float SpeckleAt(uint32_t speckleRow, int x) {
+    return Unit(Mix((uint32_t)x * HASH_X + speckleRow));
+}
+
+#if PROCTEX_SIMD
+// Helper: Low 32 bits of a 32x32 multiply in each lane (SSE2 has no pmulld)
+static inline __m128i MulLo4(__m128i a, __m128i b) {
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// Helper: SpeckleAt for columns x .. x + 3
+static inline __m128 Speckle4(uint32_t speckleRow, int x) {
+    __m128i h = _mm_add_epi32(MulLo4(_mm_add_epi32(_mm_set1_epi32(x), _mm_setr_epi32(0, 1, 2, 3)),
+                                     _mm_set1_epi32((int)HASH_X)),
+                              _mm_set1_epi32((int)speckleRow));
+    h = _mm_xor_si128(h, _mm_srli_epi32(h, 16));
+    h = MulLo4(h, _mm_set1_epi32((int)HASH_M1));
+    h = _mm_xor_si128(h, _mm_srli_epi32(h, 15));
+    h = MulLo4(h, _mm_set1_epi32((int)HASH_M2));
+    h = _mm_xor_si128(h, _mm_srli_epi32(h, 16));
+    return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(h, 8)), _mm_set1_ps(1.0f / 16777216.0f));
+}
+
+// Helper: base + (int)(n * scale) per lane
+static inline __m128i Channel4(int base, __m128 n, float scale) {
+    return _mm_add_epi32(_mm_set1_epi32(base), _mm_cvttps_epi32(_mm_mul_ps(n, _mm_set1_ps(scale))));
+}
+
+// Helper: Four opaque RGBA pixels from 0..255 channel lanes
+static inline __m128i Pack4(__m128i r, __m128i g, __m128i b) {
+    return _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)),
+                        _mm_or_si128(_mm_slli_epi32(b, 16), _mm_set1_epi32((int)0xFF000000u)));
+}
+#endif
+
+// Each row is built in two passes: a scalar pass writes the smooth part
+// (noise, block tone, grain) into the worker's scratch row, then the pixel
+// pass adds the per-pixel speckle and converts to colour, four pixels at a
+// time where SSE2 is available. Both pixel paths do the same float
+// operations in the same order, so they agree bit for bit.
+
+// Helper: Stone blocks with mortar; each block has its own tone
+static void StoneRow(const TexJob* job, int y, float* base, Color* out) {
+    const Color mortar = {50, 50, 55, 255};
+    if (((uint32_t)y & ((1u << job->blockShiftY) - 1)) < (uint32_t)job->mortarY) {
+        for (int x = 0; x < job->width; x++) out[x] = mortar;
+        return;
+    }
+
+    NoiseRow(job, y, 0.105f, base);
+    uint32_t blockRow = ((uint32_t)y >> job->blockShiftY) * HASH_Y + job->blockSeed;
+    int blockWidth = 1 << job->blockShiftX;
+    for (int x0 = 0; x0 < job->width; x0 += blockWidth) {
+        float tone = Unit(Mix((uint32_t)(x0 >> job->blockShiftX) * HASH_X + blockRow)) * 0.135f;
+        int x1 = x0 + blockWidth < job->width ? x0 + blockWidth : job->width;
+        for (int x = x0; x < x1; x++) base[x] += tone;
+    }
+
+    uint32_t speckleRow = (uint32_t)y * HASH_Y + job->speckleSeed;
+    uint32_t blockMask = (uint32_t)blockWidth - 1;
+    int x = 0;
+#if PROCTEX_SIMD
+    __m128i mortarPixels = _mm_set1_epi32((int)(50u | 50u << 8 | 55u << 16 | 0xFF000000u));
+    for (; x + 4 <= job->width; x += 4) {
+        __m128 n = _mm_add_ps(_mm_loadu_ps(&base[x]), _mm_mul_ps(Speckle4(speckleRow, x), _mm_set1_ps(0.06f)));
+        __m128i stone = Pack4(Channel4(80, n, 40.0f), Channel4(80, n, 30.0f), Channel4(85, n, 25.0f));
+        __m128i xs = _mm_add_epi32(_mm_set1_epi32(x), _mm_setr_epi32(0, 1, 2, 3));
+        __m128i inMortar = _mm_cmplt_epi32(_mm_and_si128(xs, _mm_set1_epi32((int)blockMask)),
+                                           _mm_set1_epi32(job->mortarX));
+        _mm_storeu_si128((__m128i*)&out[x], _mm_or_si128(_mm_and_si128(inMortar, mortarPixels),
+                                                          _mm_andnot_si128(inMortar, stone)));
+    }
+#endif
+    for (; x < job->width; x++) {
+        if (((uint32_t)x & blockMask) < (uint32_t)job->mortarX) {
+            out[x] = mortar;
+            continue;
+        }
+        float n = base[x] + SpeckleAt(speckleRow, x) * 0.06f;
+        out[x] = (Color){(unsigned char)(80 + (int)(n * 40.0f)), (unsigned char)(80 + (int)(n * 30.0f)),
+                         (unsigned char)(85 + (int)(n * 25.0f)), 255};
+    }
+}
+
+// Helper: Wood planks: sine grain plus streaks stretched along the plank,
+// darkened seam rows between planks
+static void WoodRow(const TexJob* job, int y, float* base, Color* out) {
+    NoiseRow(job, y, 0.12f, base);
+    int plank = y >> job->plankShift;
+    if (plank >= job->planks) plank = job->planks - 1;
+    const float* grain = &job->grain[(size_t)plank * job->width];
+    for (int x = 0; x < job->width; x++) base[x] += grain[x];
+
+    uint32_t speckleRow = (uint32_t)y * HASH_Y + job->speckleSeed;
+    bool seam = ((uint32_t)y & ((1u << job->plankShift) - 1)) < (uint32_t)job->seamRows;
+    int x = 0;
+#if PROCTEX_SIMD
+    for (; x + 4 <= job->width; x += 4) {
+        __m128 g = _mm_add_ps(_mm_loadu_ps(&base[x]), _mm_mul_ps(Speckle4(speckleRow, x), _mm_set1_ps(0.08f)));
+        __m128i r = Channel4(120, g, 40.0f);
+        __m128i gr = Channel4(90, g, 30.0f);
+        __m128i b = Channel4(60, g, 20.0f);
+        if (seam) {
+            __m128 dark = _mm_set1_ps(0.7f);
+            r = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(r), dark));
+            gr = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(gr), dark));
+            b = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(b), dark));
+        }
+        _mm_storeu_si128((__m128i*)&out[x], Pack4(r, gr, b));
+    }
+#endif
+    for (; x < job->width; x++) {
+        float g = base[x] + SpeckleAt(speckleRow, x) * 0.08f;
+        int r = 120 + (int)(g * 40.0f);
+        int gr = 90 + (int)(g * 30.0f);
+        int b = 60 + (int)(g * 20.0f);
+        if (seam) {
+            r = (int)((float)r * 0.7f);
+            gr = (int)((float)gr * 0.7f);
+            b = (int)((float)b * 0.7f);
+        }
+        out[x] = (Color){(unsigned char)r, (unsigned char)gr, (unsigned char)b, 255};
+    }
+}
+
+// Helper: Plaster: soft blotches and a little speckle
+static void CeilingRow(const TexJob* job, int y, float* base, Color* out) {
+    NoiseRow(job, y, 0.09f, base);
+    uint32_t speckleRow = (uint32_t)y * HASH_Y + job->speckleSeed;
+    int x = 0;
+#if PROCTEX_SIMD
+    for (; x + 4 <= job->width; x += 4) {
+        __m128 n = _mm_add_ps(_mm_loadu_ps(&base[x]), _mm_mul_ps(Speckle4(speckleRow, x), _mm_set1_ps(0.06f)));
+        __m128i gray = Channel4(150, n, 20.0f);
+        _mm_storeu_si128((__m128i*)&out[x], Pack4(gray, gray, Channel4(155, n, 20.0f)));
+    }
+#endif
+    for (; x < job->width; x++) {
+        float n = base[x] + SpeckleAt(speckleRow, x) * 0.06f;
+        unsigned char gray = (unsigned char)(150 + (int)(n * 20.0f));
+        out[x] = (Color){gray, gray, (unsigned char)(155 + (int)(n * 20.0f)), 255};
+    }
+}
+
+// Helper: Worker loop. Bands of rows are claimed from a shared counter;
+// every pixel is a pure function of its coordinates, so the split does not
+// change the result.
+static void* BandWorker(void* arg) {
+    TexJob* job = (TexJob*)arg;
+    float* base = &job->scratch[(size_t)atomic_fetch_add(&job->nextSlot, 1) * job->width];
+    for (int band = atomic_fetch_add(&job->nextBand, 1); band < job->bandCount;
+         band = atomic_fetch_add(&job->nextBand, 1)) {
+        int y0 = band * PROCTEX_BAND_ROWS;
+        int y1 = y0 + PROCTEX_BAND_ROWS < job->height ? y0 + PROCTEX_BAND_ROWS : job->height;
+        for (int y = y0; y < y1; y++) {
+            Color* out = &job->pixels[(size_t)y * job->width];
+            switch (job->pattern) {
+                case PROCTEX_STONE: StoneRow(job, y, base, out); break;
+                case PROCTEX_WOOD: WoodRow(job, y, base, out); break;
+                default: CeilingRow(job, y, base, out); break;
+            }
+        }
+    }
+    return NULL;
+}
+
+// Fill a width x height RGBA image with a procedural pattern. Every pixel
+// is hashed from its coordinates and the seed, so the image is the same for
+// any thread count. Feature sizes scale with the texture, and power-of-two
+// sizes tile seamlessly.
+void ProcTex_Fill(Color* pixels, int width, int height, ProcTexPattern pattern, uint32_t seed, int threadCount) {
+    if (!pixels || width < 1 || height < 1) return;
+
+    TexJob job = {0};
+    job.pattern = pattern;
+    job.pixels = pixels;
+    job.width = width;
+    job.height = height;
+    job.speckleSeed = Mix(seed + 0x9E3779B9u);
+    job.blockSeed = Mix(seed + 0x3C6EF372u);
+    job.bandCount = (height + PROCTEX_BAND_ROWS - 1) / PROCTEX_BAND_ROWS;
+    atomic_init(&job.nextSlot, 0);
+    atomic_init(&job.nextBand, 0);
+
+    const int sizeShiftX = FloorLog2(width);
+    const int sizeShiftY = FloorLog2(height);
+    const uint32_t noiseSeed = Mix(seed + 0xDAA66D2Bu);
+    switch (pattern) {
+        case PROCTEX_STONE:
+            // 8x8 blocks, mortar 1/16 of a block, noise cells a quarter block
+            job.blockShiftX = sizeShiftX > 3 ? sizeShiftX - 3 : 0;
+            job.blockShiftY = sizeShiftY > 3 ? sizeShiftY - 3 : 0;
+            job.mortarX = (1 << job.blockShiftX) >> 4 > 0 ? (1 << job.blockShiftX) >> 4 : 1;
+            job.mortarY = (1 << job.blockShiftY) >> 4 > 0 ? (1 << job.blockShiftY) >> 4 : 1;
+            job.noise = MakeLayer(noiseSeed, job.blockShiftX - 2, job.blockShiftY - 2, sizeShiftX, sizeShiftY);
+            break;
+        case PROCTEX_WOOD:
+            // Four planks, seams 1/32 of a plank, streaks a quarter texture long
+            job.plankShift = sizeShiftY > 2 ? sizeShiftY - 2 : 0;
+            job.planks = (height + (1 << job.plankShift) - 1) >> job.plankShift;
+            job.seamRows = (1 << job.plankShift) >> 5 > 0 ? (1 << job.plankShift) >> 5 : 1;
+            job.noise = MakeLayer(noiseSeed, sizeShiftX - 2, sizeShiftY - 6, sizeShiftX, sizeShiftY);
+            break;
+        default:
+            job.pattern = PROCTEX_CEILING;
+            job.noise = MakeLayer(noiseSeed, sizeShiftX - 3, sizeShiftY - 3, sizeShiftX, sizeShiftY);
+            break;
+    }
+
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > job.bandCount) threadCount = job.bandCount;
+
+    // Column tables, the wood grain and one scratch row per worker share
+    // one allocation
+    size_t columns = (size_t)width;
+    size_t floats = columns * (3 + (size_t)job.planks + (size_t)threadCount);
+    float* tables = (float*)malloc(floats * sizeof(float));
+    if (!tables) {
+        TraceLog(LOG_WARNING, "Out of memory generating a %dx%d texture", width, height);
+        return;
+    }
+    int* cell0 = (int*)tables;
+    int* cell1 = (int*)(tables + columns);
+    float* weightX = tables + 2 * columns;
+    float* grain = tables + 3 * columns;
+    job.cell0 = cell0;
+    job.cell1 = cell1;
+    job.weightX = weightX;
+    job.grain = grain;
+    job.scratch = grain + (size_t)job.planks * columns;
+
+    for (int x = 0; x < width; x++) {
+        uint32_t cx = (uint32_t)x >> job.noise.shiftX;
+        cell0[x] = (int)(cx & job.noise.maskX);
+        cell1[x] = (int)((cx + 1) & job.noise.maskX);
+        weightX[x] = Smooth((float)((uint32_t)x & ((1u << job.noise.shiftX) - 1)) * job.noise.invX);
+    }
+
+    // Four grain periods across the texture, phase shifted per plank
+    float frequency = 6.28318531f * 4.0f / (float)width;
+    for (int p = 0; p < job.planks; p++) {
+        for (int x = 0; x < width; x++) {
+            grain[(size_t)p * columns + x] = sinf((float)x * frequency + (float)p * 0.5f) * 0.1f;
+        }
+    }
+
+    // The calling thread works too
+    pthread_t* threads = threadCount > 1 ? (pthread_t*)malloc((size_t)(threadCount - 1) * sizeof(pthread_t)) : NULL;
+    int started = 0;
+    if (threads) {
+        for (; started < threadCount - 1; started++) {
+            if (pthread_create(&threads[started], NULL, BandWorker, &job) != 0) break;
+        }
+    }
+    BandWorker(&job);
+    for (int i = 0; i < started; i++) pthread_join(threads[i], NULL);
+    free(threads);
+    free(tables);
+}
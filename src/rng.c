@@ -0,0 +1,27 @@
+#include "../include/rng.h"
+
+// Seed a generator on the given stream (standard PCG32 initialisation)
+void Rng_Seed(Rng* rng, uint64_t seed, uint64_t stream) {
+    rng->state = 0u;
+    rng->inc = (stream << 1u) | 1u;
+    Rng_Next(rng);
+    rng->state += seed;
+    Rng_Next(rng);
+}
+
+// Hash two 64-bit values into a new seed (splitmix64 finaliser)
+uint64_t Rng_Mix(uint64_t a, uint64_t b) {
+    uint64_t z = a + 0x9E3779B97F4A7C15ULL * (b + 1u);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Independent generator for a subsystem; index separates instances or
+// threads of the same subsystem (e.g. one particle system per torch)
+Rng Rng_ForStream(uint64_t masterSeed, RngStream stream, uint64_t index) {
+    Rng rng;
+    uint64_t key = Rng_Mix((uint64_t)stream, index);
+    Rng_Seed(&rng, Rng_Mix(masterSeed, key), key);
+    return rng;
+}
@@ -0,0 +1,149 @@
+#define _POSIX_C_SOURCE 200809L
+#include "../include/texcache.h"
+#include "../include/filemap.h"
+#include "../include/texencode.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+#define TEXTURE_CACHE_PATH_MAX 1024
+
+// Helper: FNV-1a over a byte range
+static uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// Helper: Entry path for a key; false if it does not fit
+static bool EntryPath(char* out, size_t outSize, const char* dir, uint64_t key, const char* suffix) {
+    int n = snprintf(out, outSize, "%s/%016llx.tex%s", dir, (unsigned long long)key, suffix);
+    return n > 0 && (size_t)n < outSize;
+}
+
+// Helper: Check an entry's header against its key and file size
+static bool ValidHeader(const TextureCacheHeader* header, uint64_t key, size_t fileSize) {
+    if (fileSize < sizeof(TextureCacheHeader)) return false;
+    if (memcmp(header->magic, TEXTURE_CACHE_MAGIC, 4) != 0 || header->version != TEXTURE_CACHE_VERSION) return false;
+    if (header->key != key) return false;
+    if (header->width < 1 || header->height < 1 || header->width > 16384 || header->height > 16384) return false;
+    if (header->mipmaps < 1 || header->mipmaps > 15) return false;
+    if (header->dataOffset < sizeof(TextureCacheHeader) || header->dataOffset % TEXTURE_CACHE_ALIGN != 0) return false;
+    if (header->dataOffset > fileSize || header->dataSize > fileSize - header->dataOffset) return false;
+    return header->dataSize ==
+           TexEncode_DataSize((int)header->width, (int)header->height, (int)header->format, (int)header->mipmaps);
+}
+
+// Key for an image from everything that determines its pixels: the
+// generator's name, its parameter block (hashed as raw bytes, so clear any
+// padding), the size and the seed
+uint64_t TexCache_Key(const char* generator, const void* params, size_t paramsSize, int width, int height,
+                      uint64_t seed) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    if (generator) hash = HashBytes(hash, generator, strlen(generator) + 1);
+    if (params) hash = HashBytes(hash, params, paramsSize);
+    uint32_t size[2] = {(uint32_t)width, (uint32_t)height};
+    hash = HashBytes(hash, size, sizeof(size));
+    return HashBytes(hash, &seed, sizeof(seed));
+}
+
+// Look an image up by key. On a hit the entry's image points into a
+// mapping of the cache file, ready for LoadTextureFromImage without a
+// copy; release it with TexCache_Close. Missing entries are a quiet miss,
+// unreadable ones are reported and will be overwritten by the next store.
+bool TexCache_Open(const char* dir, uint64_t key, TextureCacheEntry* outEntry) {
+    char path[TEXTURE_CACHE_PATH_MAX];
+    if (!dir || !outEntry || !EntryPath(path, sizeof(path), dir, key, "")) return false;
+
+    size_t size = 0;
+    unsigned char* view = (unsigned char*)FileMap_Open(path, &size);
+    if (!view) return false;
+
+    const TextureCacheHeader* header = (const TextureCacheHeader*)view;
+    if (!ValidHeader(header, key, size)) {
+        TraceLog(LOG_WARNING, "Ignoring invalid texture cache entry %s", path);
+        FileMap_Close(view, size);
+        return false;
+    }
+
+    outEntry->image = (Image){
+        .data = view + header->dataOffset,
+        .width = (int)header->width,
+        .height = (int)header->height,
+        .mipmaps = (int)header->mipmaps,
+        .format = (int)header->format
+    };
+    outEntry->mapping = view;
+    outEntry->mappingSize = size;
+    return true;
+}
+
+// Release a hit from TexCache_Open
+void TexCache_Close(TextureCacheEntry* entry) {
+    if (!entry || !entry->mapping) return;
+    FileMap_Close(entry->mapping, entry->mappingSize);
+    entry->mapping = NULL;
+    entry->image.data = NULL;
+}
+
+// Store an image (with whatever mip levels it has) under a key. The entry
+// is written to a temporary file and renamed into place, so a reader never
+// sees a partial one.
+bool TexCache_Store(const char* dir, uint64_t key, const Image* image) {
+    if (!dir || !image || !image->data) return false;
+
+    char path[TEXTURE_CACHE_PATH_MAX];
+    char temp[TEXTURE_CACHE_PATH_MAX];
+    if (!EntryPath(path, sizeof(path), dir, key, "") || !EntryPath(temp, sizeof(temp), dir, key, ".tmp")) return false;
+
+    TextureCacheHeader header = {0};
+    memcpy(header.magic, TEXTURE_CACHE_MAGIC, 4);
+    header.version = TEXTURE_CACHE_VERSION;
+    header.key = key;
+    header.width = (uint32_t)image->width;
+    header.height = (uint32_t)image->height;
+    header.format = (uint32_t)image->format;
+    header.mipmaps = (uint32_t)(image->mipmaps > 0 ? image->mipmaps : 1);
+    header.dataOffset = TEXTURE_CACHE_ALIGN;
+    header.dataSize = TexEncode_DataSize(image->width, image->height, image->format, (int)header.mipmaps);
+    if (header.dataSize == 0) return false;
+
+    // The directory usually exists already
+#ifdef _WIN32
+    _mkdir(dir);
+#else
+    mkdir(dir, 0755);
+#endif
+
+    FILE* file = fopen(temp, "wb");
+    if (!file) {
+        TraceLog(LOG_WARNING, "Could not create texture cache entry %s", temp);
+        return false;
+    }
+
+    static const unsigned char padding[TEXTURE_CACHE_ALIGN] = {0};
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(padding, 1, TEXTURE_CACHE_ALIGN - sizeof(header), file) == TEXTURE_CACHE_ALIGN - sizeof(header) &&
+              fwrite(image->data, 1, (size_t)header.dataSize, file) == (size_t)header.dataSize;
+    if (fclose(file) != 0) ok = false;
+#ifdef _WIN32
+    if (ok) remove(path);  // rename does not replace on Windows
+#endif
+    if (ok) ok = rename(temp, path) == 0;
+
+    if (!ok) {
+        TraceLog(LOG_WARNING, "Failed to write texture cache entry %s", path);
+        remove(temp);
+    }
+    return ok;
+}
@@ -0,0 +1,319 @@
+#include "../include/texencode.h"
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DXT1_BLOCK_BYTES 8
+#define MAX_MIP_LEVELS   16
+
+// A mip chain being block-encoded, one row of blocks per work item
+typedef struct {
+    const unsigned char* pixels;    // RGBA8 chain
+    unsigned char* blocks;          // DXT1 chain
+    int levels;
+    int width[MAX_MIP_LEVELS], height[MAX_MIP_LEVELS];
+    size_t pixelOffset[MAX_MIP_LEVELS];
+    size_t blockOffset[MAX_MIP_LEVELS];
+    int firstRow[MAX_MIP_LEVELS + 1];   // Block rows of all earlier levels
+    atomic_int nextRow;
+} EncodeJob;
+
+// Helper: Width and height of mip level `level`, halved the way raylib does
+static void LevelSize(int width, int height, int level, int* outWidth, int* outHeight) {
+    for (int i = 0; i < level; i++) {
+        if (width > 1) width /= 2;
+        if (height > 1) height /= 2;
+    }
+    *outWidth = width;
+    *outHeight = height;
+}
+
+// Helper: Mip levels in a full chain down to 1x1
+static int FullChainLevels(int width, int height) {
+    int levels = 1;
+    while (width > 1 || height > 1) {
+        if (width > 1) width /= 2;
+        if (height > 1) height /= 2;
+        levels++;
+    }
+    return levels;
+}
+
+// Bytes of pixel data in an image with all its mip levels, as raylib
+// lays them out and uploads them (so also the GPU memory the texture
+// takes); 0 if the format is unknown
+uint64_t TexEncode_DataSize(int width, int height, int format, int mipmaps) {
+    uint64_t total = 0;
+    for (int level = 0; level < mipmaps; level++) {
+        int size = GetPixelDataSize(width, height, format);
+        if (size <= 0) return 0;
+        total += (uint64_t)size;
+        if (width > 1) width /= 2;
+        if (height > 1) height /= 2;
+    }
+    return total;
+}
+
+// Replace an RGBA8 image's mip levels with a full chain down to 1x1, each
+// level a 2x2 box filter of the one above. Unlike ImageMipmaps, which
+// resizes the base image again for every level, this reads each level
+// once.
+bool TexEncode_Mipmaps(Image* image) {
+    if (!image || !image->data || image->format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) return false;
+
+    const int levels = FullChainLevels(image->width, image->height);
+    uint64_t total = TexEncode_DataSize(image->width, image->height, image->format, levels);
+    if (total == 0 || total > UINT_MAX) return false;
+    unsigned char* data = (unsigned char*)MemRealloc(image->data, (unsigned int)total);
+    if (!data) {
+        TraceLog(LOG_WARNING, "Out of memory building mipmaps for a %dx%d image", image->width, image->height);
+        return false;
+    }
+    image->data = data;
+
+    const unsigned char* src = data;
+    int srcWidth = image->width, srcHeight = image->height;
+    for (int level = 1; level < levels; level++) {
+        int dstWidth = srcWidth > 1 ? srcWidth / 2 : 1;
+        int dstHeight = srcHeight > 1 ? srcHeight / 2 : 1;
+        unsigned char* dst = (unsigned char*)src + (size_t)srcWidth * srcHeight * 4;
+        for (int y = 0; y < dstHeight; y++) {
+            const unsigned char* row0 = src + (size_t)(2 * y < srcHeight ? 2 * y : srcHeight - 1) * srcWidth * 4;
+            const unsigned char* row1 = src + (size_t)(2 * y + 1 < srcHeight ? 2 * y + 1 : srcHeight - 1) * srcWidth * 4;
+            unsigned char* out = dst + (size_t)y * dstWidth * 4;
+            for (int x = 0; x < dstWidth; x++) {
+                int x0 = (2 * x < srcWidth ? 2 * x : srcWidth - 1) * 4;
+                int x1 = (2 * x + 1 < srcWidth ? 2 * x + 1 : srcWidth - 1) * 4;
+                for (int c = 0; c < 4; c++) {
+                    out[x * 4 + c] = (unsigned char)((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) >> 2);
+                }
+            }
+        }
+        src = dst;
+        srcWidth = dstWidth;
+        srcHeight = dstHeight;
+    }
+    image->mipmaps = levels;
+    return true;
+}
+
+// Helper: Round 8-bit RGB to a 5:6:5 colour
+static uint16_t Pack565(int r, int g, int b) {
+    return (uint16_t)(((r * 31 + 127) / 255) << 11 | ((g * 63 + 127) / 255) << 5 | ((b * 31 + 127) / 255));
+}
+
+// Helper: Expand a 5:6:5 colour to 8-bit RGB
+static void Unpack565(uint16_t color, int rgb[3]) {
+    int r = color >> 11, g = (color >> 5) & 63, b = color & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+// Helper: The four colours a DXT1 block with endpoints c0 > c1 can show
+static void BlockPalette(uint16_t c0, uint16_t c1, int palette[4][3]) {
+    Unpack565(c0, palette[0]);
+    Unpack565(c1, palette[1]);
+    for (int c = 0; c < 3; c++) {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+}
+
+// Helper: Encode one 4x4 block of RGBA8 pixels. The endpoints are the
+// corners of the block's colour bounding box, inset by 1/16 of its size
+// to stop outliers stretching the palette.
+static void EncodeBlock(const unsigned char pixels[16][4], unsigned char out[DXT1_BLOCK_BYTES]) {
+    int lo[3] = {255, 255, 255}, hi[3] = {0, 0, 0};
+    for (int i = 0; i < 16; i++) {
+        for (int c = 0; c < 3; c++) {
+            if (pixels[i][c] < lo[c]) lo[c] = pixels[i][c];
+            if (pixels[i][c] > hi[c]) hi[c] = pixels[i][c];
+        }
+    }
+    for (int c = 0; c < 3; c++) {
+        int inset = (hi[c] - lo[c]) >> 4;
+        lo[c] += inset;
+        hi[c] -= inset;
+    }
+
+    uint16_t c0 = Pack565(hi[0], hi[1], hi[2]);
+    uint16_t c1 = Pack565(lo[0], lo[1], lo[2]);
+    if (c0 < c1) {
+        uint16_t swap = c0;
+        c0 = c1;
+        c1 = swap;
+    }
+
+    // Equal endpoints would select the 3-colour mode; every pixel is c0.
+    // Otherwise each pixel is projected onto the line between the decoded
+    // endpoints and rounded to the nearest of its four palette steps.
+    uint32_t indices = 0;
+    if (c0 != c1) {
+        int palette[4][3];
+        BlockPalette(c0, c1, palette);
+        const int axis[3] = {palette[0][0] - palette[1][0], palette[0][1] - palette[1][1], palette[0][2] - palette[1][2]};
+        const int length = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+        static const uint32_t stepIndex[4] = {1, 3, 2, 0};  // Steps from c1 to c0
+        for (int i = 0; i < 16; i++) {
+            int dot = (pixels[i][0] - palette[1][0]) * axis[0] + (pixels[i][1] - palette[1][1]) * axis[1] +
+                      (pixels[i][2] - palette[1][2]) * axis[2];
+            int step = dot <= 0 ? 0 : (6 * dot + length) / (2 * length);
+            if (step > 3) step = 3;
+            indices |= stepIndex[step] << (2 * i);
+        }
+    }
+
+    out[0] = (unsigned char)(c0 & 0xFF);
+    out[1] = (unsigned char)(c0 >> 8);
+    out[2] = (unsigned char)(c1 & 0xFF);
+    out[3] = (unsigned char)(c1 >> 8);
+    for (int i = 0; i < 4; i++) out[4 + i] = (unsigned char)(indices >> (8 * i));
+}
+
+// Helper: Worker loop; rows of blocks of every level come from one counter
+static void* EncodeWorker(void* arg) {
+    EncodeJob* job = (EncodeJob*)arg;
+    const int rows = job->firstRow[job->levels];
+    for (int row = atomic_fetch_add(&job->nextRow, 1); row < rows; row = atomic_fetch_add(&job->nextRow, 1)) {
+        int level = 0;
+        while (row >= job->firstRow[level + 1]) level++;
+        const int width = job->width[level], height = job->height[level];
+        const int blocksX = (width + 3) / 4;
+        const int by = row - job->firstRow[level];
+        const unsigned char* pixels = job->pixels + job->pixelOffset[level];
+        unsigned char* out = job->blocks + job->blockOffset[level] + (size_t)by * blocksX * DXT1_BLOCK_BYTES;
+
+        // Levels smaller than a block repeat their edge pixels
+        for (int bx = 0; bx < blocksX; bx++) {
+            unsigned char block[16][4];
+            if (width >= 4 && height >= 4) {
+                for (int r = 0; r < 4; r++) {
+                    memcpy(block[r * 4], pixels + ((size_t)(by * 4 + r) * width + bx * 4) * 4, 16);
+                }
+            } else {
+                for (int i = 0; i < 16; i++) {
+                    int x = bx * 4 + (i & 3), y = by * 4 + (i >> 2);
+                    if (x >= width) x = width - 1;
+                    if (y >= height) y = height - 1;
+                    memcpy(block[i], pixels + ((size_t)y * width + x) * 4, 4);
+                }
+            }
+            EncodeBlock((const unsigned char (*)[4])block, out + (size_t)bx * DXT1_BLOCK_BYTES);
+        }
+    }
+    return NULL;
+}
+
+// Encode an RGBA8 image and all its mip levels to DXT1 (BC1, opaque) in
+// place, an eighth of the memory and texture bandwidth. Only square
+// power-of-two images are accepted: raylib sizes the small levels of
+// other shapes differently from GL. False leaves the image untouched.
+bool TexEncode_DXT1(Image* image, int threadCount) {
+    if (!image || !image->data || image->format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) return false;
+    if (image->width != image->height || image->width < 4 || (image->width & (image->width - 1)) != 0) return false;
+
+    EncodeJob job = {0};
+    job.pixels = (const unsigned char*)image->data;
+    job.levels = image->mipmaps > 0 ? image->mipmaps : 1;
+    if (job.levels > MAX_MIP_LEVELS) return false;
+    size_t pixelOffset = 0, blockOffset = 0;
+    for (int level = 0; level < job.levels; level++) {
+        int width, height;
+        LevelSize(image->width, image->height, level, &width, &height);
+        job.width[level] = width;
+        job.height[level] = height;
+        job.pixelOffset[level] = pixelOffset;
+        job.blockOffset[level] = blockOffset;
+        job.firstRow[level + 1] = job.firstRow[level] + (height + 3) / 4;
+        pixelOffset += (size_t)width * height * 4;
+        blockOffset += (size_t)GetPixelDataSize(width, height, PIXELFORMAT_COMPRESSED_DXT1_RGB);
+    }
+    job.blocks = (unsigned char*)MemAlloc((unsigned int)blockOffset);
+    if (!job.blocks) {
+        TraceLog(LOG_WARNING, "Out of memory compressing a %dx%d image", image->width, image->height);
+        return false;
+    }
+    atomic_init(&job.nextRow, 0);
+
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > job.firstRow[1]) threadCount = job.firstRow[1];
+
+    // The calling thread works too
+    pthread_t* threads = threadCount > 1 ? (pthread_t*)malloc((size_t)(threadCount - 1) * sizeof(pthread_t)) : NULL;
+    int started = 0;
+    if (threads) {
+        for (; started < threadCount - 1; started++) {
+            if (pthread_create(&threads[started], NULL, EncodeWorker, &job) != 0) break;
+        }
+    }
+    EncodeWorker(&job);
+    for (int i = 0; i < started; i++) pthread_join(threads[i], NULL);
+    free(threads);
+
+    MemFree(image->data);
+    image->data = job.blocks;
+    image->format = PIXELFORMAT_COMPRESSED_DXT1_RGB;
+    return true;
+}
+
+// Decode a DXT1 image and its mip levels back to RGBA8, for GPUs without
+// S3TC support. Returns a new image (data NULL on failure); the source is
+// left alone, so it may be a view of a cache file.
+Image TexEncode_DecodeDXT1(const Image* image) {
+    Image result = {0};
+    if (!image || !image->data || image->format != PIXELFORMAT_COMPRESSED_DXT1_RGB) return result;
+
+    const int levels = image->mipmaps > 0 ? image->mipmaps : 1;
+    uint64_t total = TexEncode_DataSize(image->width, image->height, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, levels);
+    if (total == 0 || total > UINT_MAX) return result;
+    unsigned char* data = (unsigned char*)MemAlloc((unsigned int)total);
+    if (!data) return result;
+
+    const unsigned char* blocks = (const unsigned char*)image->data;
+    unsigned char* pixels = data;
+    for (int level = 0; level < levels; level++) {
+        int width, height;
+        LevelSize(image->width, image->height, level, &width, &height);
+        const int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+        for (int by = 0; by < blocksY; by++) {
+            for (int bx = 0; bx < blocksX; bx++) {
+                const unsigned char* block = blocks + ((size_t)by * blocksX + bx) * DXT1_BLOCK_BYTES;
+                uint16_t c0 = (uint16_t)(block[0] | block[1] << 8);
+                uint16_t c1 = (uint16_t)(block[2] | block[3] << 8);
+                uint32_t indices = (uint32_t)block[4] | (uint32_t)block[5] << 8 | (uint32_t)block[6] << 16 |
+                                   (uint32_t)block[7] << 24;
+                int palette[4][3];
+                BlockPalette(c0, c1, palette);
+                if (c0 <= c1) {
+                    // 3-colour mode (never written by EncodeBlock)
+                    for (int c = 0; c < 3; c++) {
+                        palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+                        palette[3][c] = 0;
+                    }
+                }
+                for (int i = 0; i < 16; i++) {
+                    int x = bx * 4 + (i & 3), y = by * 4 + (i >> 2);
+                    if (x >= width || y >= height) continue;
+                    const int* color = palette[(indices >> (2 * i)) & 3];
+                    unsigned char* out = pixels + ((size_t)y * width + x) * 4;
+                    out[0] = (unsigned char)color[0];
+                    out[1] = (unsigned char)color[1];
+                    out[2] = (unsigned char)color[2];
+                    out[3] = 255;
+                }
+            }
+        }
+        blocks += GetPixelDataSize(width, height, PIXELFORMAT_COMPRESSED_DXT1_RGB);
+        pixels += (size_t)width * height * 4;
+    }
+
+    result.data = data;
+    result.width = image->width;
+    result.height = image->height;
+    result.mipmaps = levels;
+    result.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return result;
+}
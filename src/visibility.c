@@ -0,0 +1,659 @@
+#include "../include/visibility.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define PVS_MAX_POLY 64         // Vertex cap for the line-space polygon
+#define PVS_EPSILON  1e-6       // Slack so grazing sight lines count as visible
+#define PORTAL_EPSILON 1e-4f    // Slack on wedge tests so portals seen edge-on stay open
+#define FRUSTUM_FAR 1000.0f     // raylib's default far clip distance (RL_CULL_DISTANCE_FAR)
+
+// Create an empty visible set sized for the maze
+VisibleSet* VisibleSet_Create(const Maze* maze) {
+    if (!maze) return NULL;
+
+    VisibleSet* set = (VisibleSet*)calloc(1, sizeof(VisibleSet));
+    if (!set) return NULL;
+
+    size_t cellCount = (size_t)maze->width * maze->height;
+    set->width = maze->width;
+    set->height = maze->height;
+    set->cells = (int*)malloc(cellCount * sizeof(int));
+    set->stamp = (unsigned int*)calloc(cellCount, sizeof(unsigned int));
+    set->frame = 1;
+
+    if (!set->cells || !set->stamp) {
+        VisibleSet_Destroy(set);
+        return NULL;
+    }
+    return set;
+}
+
+// Destroy set and free memory
+void VisibleSet_Destroy(VisibleSet* set) {
+    if (!set) return;
+    free(set->cells);
+    free(set->stamp);
+    free(set);
+}
+
+// Empty the set (O(1) apart from a rare stamp wrap-around)
+void VisibleSet_Clear(VisibleSet* set) {
+    if (!set) return;
+    set->count = 0;
+    set->frame++;
+    if (set->frame == 0) {
+        memset(set->stamp, 0, (size_t)set->width * set->height * sizeof(unsigned int));
+        set->frame = 1;
+    }
+}
+
+// Add a cell (ignored if already present or out of bounds)
+void VisibleSet_Add(VisibleSet* set, int x, int y) {
+    if (!set || x < 0 || x >= set->width || y < 0 || y >= set->height) return;
+    int idx = y * set->width + x;
+    if (set->stamp[idx] == set->frame) return;
+    set->stamp[idx] = set->frame;
+    set->cells[set->count++] = idx;
+}
+
+// Check whether a cell is in the set
+bool VisibleSet_Contains(const VisibleSet* set, int x, int y) {
+    if (!set || x < 0 || x >= set->width || y < 0 || y >= set->height) return false;
+    return set->stamp[y * set->width + x] == set->frame;
+}
+
+// Convex polygon in line space: each point (m, b) is one sight line
+typedef struct {
+    double m[PVS_MAX_POLY];
+    double b[PVS_MAX_POLY];
+    int n;
+} LinePoly;
+
+// DFS frame for the sight-line search
+typedef struct {
+    int i, j;       // Cell offset from the source in reflected coordinates
+    int stage;      // Next move to try: 0 = along X, 1 = along Z, 2 = done
+    LinePoly poly;  // Sight lines that pass every portal so far
+} PvsFrame;
+
+// Helper: Keep the part of the polygon where a*m + b*bb + c >= 0. On vertex
+// overflow the polygon is left unclipped, which only makes the PVS larger.
+static void ClipPoly(const LinePoly* in, LinePoly* out, double a, double bb, double c) {
+    out->n = 0;
+    for (int k = 0; k < in->n; k++) {
+        int next = (k + 1) % in->n;
+        double d0 = a * in->m[k] + bb * in->b[k] + c;
+        double d1 = a * in->m[next] + bb * in->b[next] + c;
+
+        if (d0 >= -PVS_EPSILON) {
+            if (out->n >= PVS_MAX_POLY) { *out = *in; return; }
+            out->m[out->n] = in->m[k];
+            out->b[out->n] = in->b[k];
+            out->n++;
+        }
+        if ((d0 >= -PVS_EPSILON) != (d1 >= -PVS_EPSILON)) {
+            if (out->n >= PVS_MAX_POLY) { *out = *in; return; }
+            double t = d0 / (d0 - d1);
+            out->m[out->n] = in->m[k] + t * (in->m[next] - in->m[k]);
+            out->b[out->n] = in->b[k] + t * (in->b[next] - in->b[k]);
+            out->n++;
+        }
+    }
+}
+
+// Helper: Restrict sight lines to those crossing a portal. In line space the
+// major axis is u and lines are v = m*u + b with m in [0, 1]. A portal lies
+// either on u = c with v in [lo, hi], or on v = c with u in [lo, hi].
+static void ClipPortal(const LinePoly* in, LinePoly* out, bool acrossMajor, double c, double lo, double hi) {
+    LinePoly tmp;
+    if (acrossMajor) {
+        // lo <= m*c + b <= hi
+        ClipPoly(in, &tmp, c, 1.0, -lo);
+        ClipPoly(&tmp, out, -c, -1.0, hi);
+    } else {
+        // m*lo <= c - b <= m*hi (the line crosses v = c at u = (c - b) / m)
+        ClipPoly(in, &tmp, -lo, -1.0, c);
+        ClipPoly(&tmp, out, hi, 1.0, -c);
+    }
+}
+
+// Helper: Mark every cell a straight line can reach from (ax, ay) while
+// moving only towards +sx / +sy. xMajor picks which axis the line space is
+// parameterised on, so the two calls together cover every slope.
+static void TraceQuadrant(const Maze* maze, int ax, int ay, int sx, int sy, bool xMajor,
+                          PvsFrame* stack, int* mark, int markValue, int* outCells, int* outCount) {
+    const int dirX = sx > 0 ? MAZE_EAST : MAZE_WEST;
+    const int dirY = sy > 0 ? MAZE_SOUTH : MAZE_NORTH;
+    const double bound = (double)(maze->width + maze->height + 2);
+
+    int top = 0;
+    PvsFrame* root = &stack[top++];
+    root->i = 0;
+    root->j = 0;
+    root->stage = 0;
+    root->poly.n = 4;
+    root->poly.m[0] = 0.0; root->poly.b[0] = -bound;
+    root->poly.m[1] = 1.0; root->poly.b[1] = -bound;
+    root->poly.m[2] = 1.0; root->poly.b[2] = bound;
+    root->poly.m[3] = 0.0; root->poly.b[3] = bound;
+
+    while (top > 0) {
+        PvsFrame* f = &stack[top - 1];
+        if (f->stage >= 2) {
+            top--;
+            continue;
+        }
+
+        bool alongX = (f->stage == 0);
+        f->stage++;
+
+        int x = ax + sx * f->i;
+        int y = ay + sy * f->j;
+        if (Maze_HasWall(maze, x, y, alongX ? dirX : dirY)) continue;
+
+        // Portal between this cell and the next, in source-centred reflected
+        // cell units (the source cell spans [-0.5, 0.5] on both axes)
+        double c = (alongX ? f->i : f->j) + 0.5;
+        double mid = alongX ? f->j : f->i;
+        PvsFrame* child = &stack[top];
+        ClipPortal(&f->poly, &child->poly, alongX == xMajor, c, mid - 0.5, mid + 0.5);
+        if (child->poly.n == 0) continue;
+
+        child->i = f->i + (alongX ? 1 : 0);
+        child->j = f->j + (alongX ? 0 : 1);
+        child->stage = 0;
+        top++;
+
+        int idx = (ay + sy * child->j) * maze->width + (ax + sx * child->i);
+        if (mark[idx] != markValue) {
+            mark[idx] = markValue;
+            outCells[(*outCount)++] = idx;
+        }
+    }
+}
+
+// Compute the conservative PVS of every cell. A cell is visible from another
+// when some straight line passes through every portal on a monotone path
+// between them; wall thickness is ignored, which only adds cells.
+Pvs* Pvs_Build(const Maze* maze) {
+    if (!maze) return NULL;
+
+    clock_t start = clock();
+    const int width = maze->width;
+    const int cellCount = width * maze->height;
+
+    Pvs* pvs = (Pvs*)calloc(1, sizeof(Pvs));
+    if (!pvs) return NULL;
+    pvs->width = width;
+    pvs->height = maze->height;
+    pvs->boxes = (int*)malloc((size_t)cellCount * 4 * sizeof(int));
+    pvs->bitOffsets = (size_t*)malloc((size_t)cellCount * sizeof(size_t));
+
+    // Scratch: monotone paths are at most width + height steps long
+    PvsFrame* stack = (PvsFrame*)malloc((size_t)(width + maze->height + 2) * sizeof(PvsFrame));
+    int* mark = (int*)malloc((size_t)cellCount * sizeof(int));
+    int* visible = (int*)malloc((size_t)cellCount * sizeof(int));
+    size_t bitCapacity = (size_t)cellCount * 32;
+    pvs->bits = (uint32_t*)calloc(bitCapacity / 32, sizeof(uint32_t));
+
+    if (!pvs->boxes || !pvs->bitOffsets || !stack || !mark || !visible || !pvs->bits) {
+        free(stack);
+        free(mark);
+        free(visible);
+        Pvs_Destroy(pvs);
+        return NULL;
+    }
+    for (int i = 0; i < cellCount; i++) mark[i] = -1;
+
+    for (int cell = 0; cell < cellCount; cell++) {
+        int ax = cell % width;
+        int ay = cell / width;
+
+        int count = 0;
+        mark[cell] = cell;
+        visible[count++] = cell;
+        for (int q = 0; q < 8; q++) {
+            int sx = (q & 1) ? -1 : 1;
+            int sy = (q & 2) ? -1 : 1;
+            TraceQuadrant(maze, ax, ay, sx, sy, (q & 4) != 0, stack, mark, cell, visible, &count);
+        }
+
+        // Bounding box of the visible cells
+        int x0 = ax, y0 = ay, x1 = ax, y1 = ay;
+        for (int k = 0; k < count; k++) {
+            int vx = visible[k] % width;
+            int vy = visible[k] / width;
+            if (vx < x0) x0 = vx;
+            if (vx > x1) x1 = vx;
+            if (vy < y0) y0 = vy;
+            if (vy > y1) y1 = vy;
+        }
+        int boxW = x1 - x0 + 1;
+        int boxH = y1 - y0 + 1;
+
+        // Grow the shared bit array if this cell's box does not fit
+        size_t need = pvs->bitCount + (size_t)boxW * boxH;
+        if (need > bitCapacity) {
+            size_t newCapacity = bitCapacity * 2 > need ? bitCapacity * 2 : need + 32;
+            uint32_t* grown = (uint32_t*)realloc(pvs->bits, (newCapacity + 31) / 32 * sizeof(uint32_t));
+            if (!grown) {
+                free(stack);
+                free(mark);
+                free(visible);
+                Pvs_Destroy(pvs);
+                return NULL;
+            }
+            memset(grown + (bitCapacity + 31) / 32, 0, ((newCapacity + 31) / 32 - (bitCapacity + 31) / 32) * sizeof(uint32_t));
+            pvs->bits = grown;
+            bitCapacity = newCapacity;
+        }
+
+        pvs->boxes[cell * 4 + 0] = x0;
+        pvs->boxes[cell * 4 + 1] = y0;
+        pvs->boxes[cell * 4 + 2] = boxW;
+        pvs->boxes[cell * 4 + 3] = boxH;
+        pvs->bitOffsets[cell] = pvs->bitCount;
+        for (int k = 0; k < count; k++) {
+            size_t bit = pvs->bitCount + (size_t)(visible[k] / width - y0) * boxW + (visible[k] % width - x0);
+            pvs->bits[bit / 32] |= 1u << (bit % 32);
+        }
+        pvs->bitCount = need;
+        pvs->totalVisible += count;
+    }
+
+    free(stack);
+    free(mark);
+    free(visible);
+
+    pvs->buildSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    return pvs;
+}
+
+// Destroy PVS and free memory
+void Pvs_Destroy(Pvs* pvs) {
+    if (!pvs || pvs->borrowed) return;
+    free(pvs->boxes);
+    free(pvs->bitOffsets);
+    free(pvs->bits);
+    free(pvs);
+}
+
+// Fill a visible set with the PVS of one cell
+void Pvs_Gather(const Pvs* pvs, int x, int y, VisibleSet* out) {
+    if (!pvs || !out) return;
+    VisibleSet_Clear(out);
+    if (x < 0 || x >= pvs->width || y < 0 || y >= pvs->height) return;
+
+    int cell = y * pvs->width + x;
+    const int* box = &pvs->boxes[cell * 4];
+    size_t bit = pvs->bitOffsets[cell];
+
+    for (int by = 0; by < box[3]; by++) {
+        for (int bx = 0; bx < box[2]; bx++, bit++) {
+            if (pvs->bits[bit / 32] & (1u << (bit % 32))) {
+                VisibleSet_Add(out, box[0] + bx, box[1] + by);
+            }
+        }
+    }
+}
+
+// Average number of cells in a PVS
+float Pvs_AverageSize(const Pvs* pvs) {
+    if (!pvs || pvs->width * pvs->height == 0) return 0.0f;
+    return (float)((double)pvs->totalVisible / ((double)pvs->width * pvs->height));
+}
+
+// Range of view directions in the XZ plane, swept counter-clockwise from
+// "from" to "to" (always under 180 degrees unless full is set)
+typedef struct {
+    Vector2 from, to;
+    bool full;
+} Wedge;
+
+// Traversal frame: a cell, the edge it was entered through and the part of
+// the view that reaches it
+struct PortalFrame {
+    int x, y;
+    int cameFrom;
+    Wedge wedge;
+};
+
+// What the current gather already pushed into a cell through one side; the
+// slot is empty unless its stamp is the culler's current gather
+struct PortalSeen {
+    size_t key;             // cell * 4 + entry side
+    unsigned int stamp;
+    Wedge wedge;
+};
+
+#define PORTAL_SEEN_INITIAL 1024
+
+static float Cross2(Vector2 a, Vector2 b) {
+    return a.x * b.y - a.y * b.x;
+}
+
+// Helper: Check whether a direction lies inside a (partial) wedge
+static bool WedgeContains(Wedge w, Vector2 d) {
+    return Cross2(w.from, d) >= -PORTAL_EPSILON && Cross2(d, w.to) >= -PORTAL_EPSILON;
+}
+
+// Helper: Intersect two wedges sharing the eye as apex. Both are convex, so
+// the result is a single wedge bounded by the inner pair of edges.
+static bool IntersectWedge(Wedge a, Wedge b, Wedge* out) {
+    if (a.full) { *out = b; return true; }
+    if (b.full) { *out = a; return true; }
+
+    out->full = false;
+    if (WedgeContains(a, b.from)) out->from = b.from;
+    else if (WedgeContains(b, a.from)) out->from = a.from;
+    else return false;
+
+    if (WedgeContains(a, b.to)) out->to = b.to;
+    else if (WedgeContains(b, a.to)) out->to = a.to;
+    else return false;
+
+    return Cross2(out->from, out->to) >= -PORTAL_EPSILON;
+}
+
+// Helper: Check whether wedge a already covers all of wedge b
+static bool WedgeCovers(Wedge a, Wedge b) {
+    if (a.full) return true;
+    if (b.full) return false;
+    return WedgeContains(a, b.from) && WedgeContains(a, b.to) && WedgeContains(a, (Vector2){
+        b.from.x + b.to.x, b.from.y + b.to.y});
+}
+
+// Helper: Smallest wedge around two overlapping ones, or false if they are
+// disjoint (their hull could pass 180 degrees)
+static bool MergeWedge(Wedge a, Wedge b, Wedge* out) {
+    if (a.full || b.full) {
+        *out = (Wedge){.full = true};
+        return true;
+    }
+    out->full = false;
+    if (WedgeContains(a, b.from)) out->from = a.from;
+    else if (WedgeContains(b, a.from)) out->from = b.from;
+    else return false;
+    if (WedgeContains(a, b.to)) out->to = a.to;
+    else if (WedgeContains(b, a.to)) out->to = b.to;
+    else return false;
+    return Cross2(out->from, out->to) >= -PORTAL_EPSILON;
+}
+
+// Helper: Slot for a (cell, side) key in the current gather, claiming an
+// empty one if it is not there yet. NULL if the table could not grow.
+static struct PortalSeen* FindSeen(PortalCuller* culler, size_t key, bool* outFound) {
+    if ((culler->seenCount + 1) * 2 > culler->seenCapacity) {
+        int newCapacity = culler->seenCapacity * 2;
+        struct PortalSeen* grown = (struct PortalSeen*)calloc((size_t)newCapacity, sizeof(struct PortalSeen));
+        if (!grown) return NULL;
+        for (int i = 0; i < culler->seenCapacity; i++) {
+            const struct PortalSeen* old = &culler->seen[i];
+            if (old->stamp != culler->gather) continue;
+            size_t slot = (old->key * 0x9E3779B97F4A7C15ull >> 16) & (size_t)(newCapacity - 1);
+            while (grown[slot].stamp == culler->gather) slot = (slot + 1) & (size_t)(newCapacity - 1);
+            grown[slot] = *old;
+        }
+        free(culler->seen);
+        culler->seen = grown;
+        culler->seenCapacity = newCapacity;
+    }
+
+    size_t mask = (size_t)culler->seenCapacity - 1;
+    size_t slot = (key * 0x9E3779B97F4A7C15ull >> 16) & mask;
+    while (culler->seen[slot].stamp == culler->gather) {
+        if (culler->seen[slot].key == key) {
+            *outFound = true;
+            return &culler->seen[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+    *outFound = false;
+    culler->seen[slot].key = key;
+    culler->seen[slot].stamp = culler->gather;
+    culler->seenCount++;
+    return &culler->seen[slot];
+}
+
+// Helper: Horizontal view wedge of the camera. Pitching tilts the frustum
+// corners forward or back, so the XZ footprint widens; past the point where
+// a corner ray points behind the eye the whole circle counts as visible.
+static Wedge ViewWedge(Vector3 forward, float fovy, float aspect) {
+    Wedge w = {0};
+    float flat = sqrtf(forward.x * forward.x + forward.z * forward.z);
+    float len = sqrtf(flat * flat + forward.y * forward.y);
+    if (flat < PORTAL_EPSILON || len < PORTAL_EPSILON) {
+        w.full = true;
+        return w;
+    }
+
+    float cosPitch = flat / len;
+    float sinPitch = fabsf(forward.y) / len;
+    float tanV = tanf(fovy * 0.5f * DEG2RAD);
+    float tanH = tanV * aspect;
+    float reach = cosPitch - tanV * sinPitch;   // Forward extent of the lowest/highest corner ray
+    if (reach <= PORTAL_EPSILON) {
+        w.full = true;
+        return w;
+    }
+
+    float spread = tanH / reach;
+    Vector2 f = {forward.x / flat, forward.z / flat};
+    Vector2 r = {-f.y, f.x};
+    w.from = (Vector2){f.x - r.x * spread, f.y - r.y * spread};
+    w.to = (Vector2){f.x + r.x * spread, f.y + r.y * spread};
+    return w;
+}
+
+// Create a portal culler for a maze
+PortalCuller* PortalCuller_Create(const Maze* maze) {
+    if (!maze) return NULL;
+
+    PortalCuller* culler = (PortalCuller*)calloc(1, sizeof(PortalCuller));
+    if (!culler) return NULL;
+
+    culler->maze = maze;
+    culler->stackCapacity = 256;
+    culler->stack = (struct PortalFrame*)malloc((size_t)culler->stackCapacity * sizeof(struct PortalFrame));
+    culler->seenCapacity = PORTAL_SEEN_INITIAL;
+    culler->seen = (struct PortalSeen*)calloc((size_t)culler->seenCapacity, sizeof(struct PortalSeen));
+    if (!culler->stack || !culler->seen) {
+        PortalCuller_Destroy(culler);
+        return NULL;
+    }
+    return culler;
+}
+
+// Destroy culler and free memory
+void PortalCuller_Destroy(PortalCuller* culler) {
+    if (!culler) return;
+    free(culler->stack);
+    free(culler->seen);
+    free(culler);
+}
+
+// Collect the cells visible from the eye. Starting at the camera cell, each
+// open edge whose span still overlaps the view narrows it to that portal and
+// is followed. A cell is entered through the same side again only with view
+// the gather has not pushed there yet, so loops in the maze terminate.
+// Returns false if the eye is outside the maze.
+bool PortalCuller_Gather(PortalCuller* culler, Vector3 eye, Vector3 forward, float fovy, float aspect,
+                         VisibleSet* out) {
+    if (!culler || !out) return false;
+    VisibleSet_Clear(out);
+    culler->visited = 0;
+    culler->drawn = 0;
+
+    const Maze* maze = culler->maze;
+    int startX, startY;
+    Maze_WorldToCell(maze, eye.x, eye.z, &startX, &startY);
+    if (startX < 0 || startX >= maze->width || startY < 0 || startY >= maze->height) return false;
+
+    static const int dirs[4] = {MAZE_NORTH, MAZE_EAST, MAZE_SOUTH, MAZE_WEST};
+    static const int dx[4] = {0, 1, 0, -1};
+    static const int dy[4] = {-1, 0, 1, 0};
+    const float size = maze->cellSize;
+    const float originX = -maze->width * 0.5f * size;
+    const float originZ = -maze->height * 0.5f * size;
+
+    // New stamp for seen[]; on wrap-around every slot is cleared once
+    if (++culler->gather == 0) {
+        memset(culler->seen, 0, (size_t)culler->seenCapacity * sizeof(struct PortalSeen));
+        culler->gather = 1;
+    }
+    culler->seenCount = 0;
+
+    // Backstop: a gather that somehow keeps finding new view stops after
+    // four pushes per cell
+    const long long maxPushes = 4LL * maze->width * maze->height;
+    long long pushes = 0;
+
+    int top = 0;
+    culler->stack[top++] = (struct PortalFrame){startX, startY, -1, ViewWedge(forward, fovy, aspect)};
+
+    while (top > 0) {
+        struct PortalFrame f = culler->stack[--top];
+        culler->visited++;
+        VisibleSet_Add(out, f.x, f.y);
+
+        // Cell corners relative to the eye
+        float x0 = originX + f.x * size - eye.x;
+        float z0 = originZ + f.y * size - eye.z;
+        float x1 = x0 + size;
+        float z1 = z0 + size;
+
+        for (int d = 0; d < 4; d++) {
+            if (d == f.cameFrom || Maze_HasWall(maze, f.x, f.y, dirs[d])) continue;
+            int nx = f.x + dx[d];
+            int ny = f.y + dy[d];
+            if (nx < 0 || nx >= maze->width || ny < 0 || ny >= maze->height) continue;
+
+            // Portal endpoints, ordered counter-clockwise as seen from the eye
+            Vector2 p0, p1;
+            switch (dirs[d]) {
+                case MAZE_NORTH: p0 = (Vector2){x0, z0}; p1 = (Vector2){x1, z0}; break;
+                case MAZE_EAST:  p0 = (Vector2){x1, z0}; p1 = (Vector2){x1, z1}; break;
+                case MAZE_SOUTH: p0 = (Vector2){x1, z1}; p1 = (Vector2){x0, z1}; break;
+                default:         p0 = (Vector2){x0, z1}; p1 = (Vector2){x0, z0}; break;
+            }
+            if (Cross2(p0, p1) < 0.0f) {
+                Vector2 t = p0; p0 = p1; p1 = t;
+            }
+
+            // An eye on (or next to) the portal line sees through all of it,
+            // so keep the current view instead of a degenerate wedge
+            Wedge next;
+            float span = sqrtf((p1.x - p0.x) * (p1.x - p0.x) + (p1.y - p0.y) * (p1.y - p0.y));
+            if (fabsf(Cross2(p0, p1)) <= PORTAL_EPSILON * span * size) {
+                next = f.wedge;
+            } else {
+                Wedge portal = {p0, p1, false};
+                if (!IntersectWedge(f.wedge, portal, &next)) continue;
+            }
+
+            // Skip view already pushed into the neighbour through this side,
+            // otherwise push the union so the stored wedge only ever widens
+            // (disjoint views fall back to the full wedge, still clipped by
+            // every later portal)
+            bool found;
+            struct PortalSeen* seen = FindSeen(culler, ((size_t)ny * maze->width + nx) * 4 + (size_t)((d + 2) % 4),
+                                               &found);
+            if (seen && found) {
+                if (WedgeCovers(seen->wedge, next)) continue;
+                Wedge merged;
+                next = MergeWedge(seen->wedge, next, &merged) ? merged : (Wedge){.full = true};
+            }
+            if (seen) seen->wedge = next;
+
+            if (++pushes > maxPushes) {
+                TraceLog(LOG_WARNING, "Portal traversal passed %lld pushes, view truncated", maxPushes);
+                top = 0;
+                break;
+            }
+            if (top >= culler->stackCapacity) {
+                int newCapacity = culler->stackCapacity * 2;
+                struct PortalFrame* grown = (struct PortalFrame*)realloc(culler->stack,
+                    (size_t)newCapacity * sizeof(struct PortalFrame));
+                if (!grown) {
+                    TraceLog(LOG_WARNING, "Portal traversal stack exhausted, view truncated");
+                    break;
+                }
+                culler->stack = grown;
+                culler->stackCapacity = newCapacity;
+            }
+            // The neighbour was entered through its edge facing this cell
+            culler->stack[top++] = (struct PortalFrame){nx, ny, (d + 2) % 4, next};
+        }
+    }
+
+    culler->drawn = out->count;
+    return true;
+}
+
+static Vector3 Cross3(Vector3 a, Vector3 b) {
+    return (Vector3){a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+static Vector3 Normalize3(Vector3 v) {
+    float len = sqrtf(v.x * v.x + v.y * v.y + v.z * v.z);
+    if (len <= 0.0f) return v;
+    return (Vector3){v.x / len, v.y / len, v.z / len};
+}
+
+static float Dot3(Vector3 a, Vector3 b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+// Build the view frustum of a perspective camera
+Frustum Frustum_FromCamera(Camera3D camera, float aspect) {
+    Frustum frustum = {0};
+    frustum.eye = camera.position;
+    frustum.farDistance = FRUSTUM_FAR;
+
+    Vector3 f = Normalize3((Vector3){camera.target.x - camera.position.x, camera.target.y - camera.position.y,
+                                     camera.target.z - camera.position.z});
+    Vector3 r = Normalize3(Cross3(f, camera.up));
+    Vector3 u = Cross3(r, f);
+    float tanV = tanf(camera.fovy * 0.5f * DEG2RAD);
+    float tanH = tanV * aspect;
+
+    // Each side plane holds the eye, one frustum edge direction and the
+    // perpendicular screen axis; orient its normal towards the view axis
+    Vector3 edges[4] = {
+        {f.x - r.x * tanH, f.y - r.y * tanH, f.z - r.z * tanH},
+        {f.x + r.x * tanH, f.y + r.y * tanH, f.z + r.z * tanH},
+        {f.x - u.x * tanV, f.y - u.y * tanV, f.z - u.z * tanV},
+        {f.x + u.x * tanV, f.y + u.y * tanV, f.z + u.z * tanV}
+    };
+    for (int i = 0; i < 4; i++) {
+        Vector3 n = Normalize3(Cross3(edges[i], i < 2 ? u : r));
+        if (Dot3(n, f) < 0.0f) n = (Vector3){-n.x, -n.y, -n.z};
+        frustum.normals[i] = n;
+    }
+    frustum.normals[4] = f;                         // Near (at the eye)
+    frustum.normals[5] = (Vector3){-f.x, -f.y, -f.z}; // Far, offset by farDistance
+    return frustum;
+}
+
+// Check whether an axis-aligned box overlaps the frustum (conservative: a box
+// straddling two planes outside a corner may pass)
+bool Frustum_ContainsBox(const Frustum* frustum, BoundingBox box) {
+    if (!frustum) return true;
+
+    for (int i = 0; i < 6; i++) {
+        Vector3 n = frustum->normals[i];
+
+        // Corner furthest along the normal
+        Vector3 p = {
+            n.x >= 0.0f ? box.max.x : box.min.x,
+            n.y >= 0.0f ? box.max.y : box.min.y,
+            n.z >= 0.0f ? box.max.z : box.min.z
+        };
+        float d = Dot3(n, (Vector3){p.x - frustum->eye.x, p.y - frustum->eye.y, p.z - frustum->eye.z});
+        if (i == 5) d += frustum->farDistance;
+        if (d < 0.0f) return false;
+    }
+    return true;
+}
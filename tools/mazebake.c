@@ -0,0 +1,119 @@
+#include "raylib.h"
+#include "../include/maze.h"
+#include "../include/levelpack.h"
+#include "../include/rng.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Defaults matching the game (src/main.c)
+#define BAKE_CELL_SIZE    3.0f
+#define BAKE_WALL_HEIGHT  4.0f
+#define BAKE_WALL_THICK   0.2f
+#define BAKE_MAX_TORCHES  25
+
+// Helper: Wall-clock seconds
+static double Now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Level pack baker:
+//   mazebake [--size WxH] [--seed S] [--level L] [--algo NAME] [--threads N] [--packed]
+//            [--torches N] [--no-pvs] [--out FILE]
+// Generates level L of master seed S (the maze the game plays with --seed S
+// after L restarts) and bakes it, its wall mesh, PVS and torches into FILE
+// (default level.pack). Play it with `maze --pack FILE`.
+int main(int argc, char** argv) {
+    int width = 15;
+    int height = 15;
+    uint64_t seed = 1;
+    uint64_t level = 0;
+    MazeAlgorithm algorithm = MAZE_ALGO_BACKTRACKER;
+    int threads = 0;
+    bool packed = false;
+    int maxTorches = BAKE_MAX_TORCHES;
+    bool withPvs = true;
+    const char* path = "level.pack";
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%dx%d", &width, &height) != 2 || width < 1 || height < 1) {
+                fprintf(stderr, "Invalid --size, expected WxH\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--level") == 0 && i + 1 < argc) {
+            level = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--algo") == 0 && i + 1 < argc) {
+            if (!Maze_AlgorithmFromName(argv[++i], &algorithm)) {
+                fprintf(stderr, "Unknown algorithm '%s'\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]) > 0 ? atoi(argv[i]) : Maze_HardwareThreads();
+        } else if (strcmp(argv[i], "--packed") == 0) {
+            packed = true;
+        } else if (strcmp(argv[i], "--torches") == 0 && i + 1 < argc) {
+            maxTorches = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--no-pvs") == 0) {
+            withPvs = false;
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            path = argv[++i];
+        } else {
+            fprintf(stderr, "Usage: %s [--size WxH] [--seed S] [--level L] [--algo NAME] [--threads N] "
+                    "[--packed] [--torches N] [--no-pvs] [--out FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    // Same derivation as the game's InitGame
+    uint64_t levelSeed = Rng_Mix(seed, level);
+    Maze* maze = Maze_CreateEx(width, height, BAKE_CELL_SIZE, packed ? MAZE_STORAGE_PACKED : MAZE_STORAGE_BYTES);
+    if (!maze) {
+        fprintf(stderr, "Failed to allocate %dx%d maze\n", width, height);
+        return 1;
+    }
+    maze->seed = levelSeed;
+
+    double start = Now();
+    Rng mazeRng = Rng_ForStream(levelSeed, RNG_STREAM_MAZE, 0);
+    bool generated = threads > 0 ? Maze_GenerateParallel(maze, algorithm, &mazeRng, threads, MAZE_PARALLEL_TILE)
+                                 : Maze_GenerateWith(maze, algorithm, &mazeRng);
+    double generateSeconds = Now() - start;
+    if (!generated) {
+        fprintf(stderr, "Failed to generate the maze\n");
+        Maze_Destroy(maze);
+        return 1;
+    }
+
+    start = Now();
+    bool baked = LevelPack_Bake(maze, path, BAKE_WALL_HEIGHT, BAKE_WALL_THICK, maxTorches, withPvs);
+    double bakeSeconds = Now() - start;
+    Maze_Destroy(maze);
+    if (!baked) {
+        fprintf(stderr, "Failed to bake %s\n", path);
+        return 1;
+    }
+
+    // Time what the game pays to load it
+    LevelPack pack;
+    start = Now();
+    Maze* loaded = LevelPack_Open(path, &pack);
+    double openSeconds = Now() - start;
+    if (!loaded) return 1;
+
+    printf("%s: %dx%d %s level %llu (seed %llu), %.1f MB\n", path, width, height, Maze_AlgorithmName(algorithm),
+           (unsigned long long)level, (unsigned long long)seed, loaded->mappingSize / (1024.0 * 1024.0));
+    printf("  %d wall runs, %d mesh pieces, %d quads, %d torches, PVS %s\n", pack.wallCount,
+           pack.mesh.pieceCount, pack.mesh.quadCount, pack.torchCount,
+           pack.pvs.width ? "baked" : "not baked");
+    printf("  generate %.3f s, bake %.3f s, open %.3f ms\n", generateSeconds, bakeSeconds, openSeconds * 1000.0);
+    Maze_Destroy(loaded);
+    return 0;
+}
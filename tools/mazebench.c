@@ -0,0 +1,591 @@
+#define _POSIX_C_SOURCE 200809L
+#include "raylib.h"
+#include "../include/maze.h"
+#include "../include/chunkedmaze.h"
+#include "../include/compressedmaze.h"
+#include "../include/flowfield.h"
+#include "../include/mazewindow.h"
+#include "../include/rng.h"
+#include "../include/visibility.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+// Helper: Wall-clock seconds (clock() would add up every thread's CPU time)
+static double Now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static const char* s_layoutNames[] = {"bytes", "packed", "tiled", "morton"};
+
+// Helper: Random circle queries against the maze, returns the hit count
+static int BenchCollision(const Maze* maze, int queries, uint64_t seed, double* outSeconds) {
+    Rng rng = Rng_ForStream(seed, RNG_STREAM_MAZE, 0xC011);
+    float halfW = maze->width * 0.5f * maze->cellSize;
+    float halfH = maze->height * 0.5f * maze->cellSize;
+    int hits = 0;
+    double start = Now();
+    for (int i = 0; i < queries; i++) {
+        Vector2 p = {(Rng_Float(&rng) * 2.0f - 1.0f) * halfW, (Rng_Float(&rng) * 2.0f - 1.0f) * halfH};
+        if (Maze_CollidesCircle(maze, p, 0.3f)) hits++;
+    }
+    *outSeconds = Now() - start;
+    return hits;
+}
+
+// Helper: Circle vs rectangle, the same test Maze_CollidesCircle applies
+static bool CircleHitsRect(Vector2 c, float r, Rectangle rect) {
+    float nx = c.x < rect.x ? rect.x : c.x > rect.x + rect.width ? rect.x + rect.width : c.x;
+    float nz = c.y < rect.y ? rect.y : c.y > rect.y + rect.height ? rect.y + rect.height : c.y;
+    float dx = c.x - nx;
+    float dz = c.y - nz;
+    return dx * dx + dz * dz <= r * r;
+}
+
+// Helper: Reference answer: test the circle against every wall rectangle
+static bool LinearCollides(const WallRect* rects, int count, Vector2 center, float radius) {
+    for (int i = 0; i < count; i++) {
+        if (CircleHitsRect(center, radius, rects[i].rect)) return true;
+    }
+    return false;
+}
+
+// Helper: Collision cost across maze sizes. The same random probes (random
+// radii up to one cell, some just outside the maze) go through
+// Maze_CollidesCircle and through a linear scan over Maze_GetWallRects; the
+// answers must agree. Returns the number of mismatches.
+static long long RunCollisionCheck(uint64_t seed) {
+    static const int sizes[] = {15, 100, 500, 2000};
+    long long mismatches = 0;
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        const int size = sizes[s];
+        Maze* maze = Maze_Create(size, size, 1.0f);
+        size_t maxRects = (size_t)size * size * 2 + 2 * (size_t)size;
+        WallRect* rects = (WallRect*)malloc(maxRects * sizeof(WallRect));
+        if (!maze || !rects) {
+            fprintf(stderr, "Failed to allocate a %dx%d maze\n", size, size);
+            Maze_Destroy(maze);
+            free(rects);
+            return mismatches + 1;
+        }
+        Rng rng = Rng_ForStream(seed, RNG_STREAM_MAZE, (uint64_t)size);
+        Maze_GenerateWith(maze, MAZE_ALGO_BACKTRACKER, &rng);
+        int rectCount = Maze_GetWallRects(maze, rects, (int)maxRects);
+
+        // Enough probes for a stable time without the linear scan taking
+        // more than about 2e8 rectangle tests
+        int probeCount = (int)(200000000LL / rectCount);
+        if (probeCount > 100000) probeCount = 100000;
+        if (probeCount < 200) probeCount = 200;
+        Vector2* centers = (Vector2*)malloc((size_t)probeCount * sizeof(Vector2));
+        float* radii = (float*)malloc((size_t)probeCount * sizeof(float));
+        bool* expected = (bool*)malloc((size_t)probeCount * sizeof(bool));
+        if (!centers || !radii || !expected) {
+            fprintf(stderr, "Failed to allocate %d probes\n", probeCount);
+            free(centers);
+            free(radii);
+            free(expected);
+            free(rects);
+            Maze_Destroy(maze);
+            return mismatches + 1;
+        }
+        Rng probeRng = Rng_ForStream(seed, RNG_STREAM_MAZE, 0xC011);
+        float half = (size * 0.5f + 1.0f) * maze->cellSize;
+        for (int i = 0; i < probeCount; i++) {
+            centers[i] = (Vector2){(Rng_Float(&probeRng) * 2.0f - 1.0f) * half,
+                                   (Rng_Float(&probeRng) * 2.0f - 1.0f) * half};
+            radii[i] = (0.02f + Rng_Float(&probeRng) * 0.98f) * maze->cellSize;
+        }
+
+        double start = Now();
+        int linearHits = 0;
+        for (int i = 0; i < probeCount; i++) {
+            expected[i] = LinearCollides(rects, rectCount, centers[i], radii[i]);
+            linearHits += expected[i];
+        }
+        double linearNs = (Now() - start) * 1e9 / probeCount;
+
+        long long sizeMismatches = 0;
+        for (int i = 0; i < probeCount; i++) {
+            if (Maze_CollidesCircle(maze, centers[i], radii[i]) != expected[i]) sizeMismatches++;
+        }
+
+        // Repeat the probe set until the fast path has made ~1M queries
+        int rounds = (1000000 + probeCount - 1) / probeCount;
+        volatile int gridHits = 0;
+        start = Now();
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < probeCount; i++) gridHits += Maze_CollidesCircle(maze, centers[i], radii[i]);
+        }
+        double gridNs = (Now() - start) * 1e9 / ((double)rounds * probeCount);
+
+        printf("collision %dx%d: %d walls, %d probes (%d hits): Maze_CollidesCircle %.1f ns, linear scan %.0f ns, "
+               "%lld mismatches\n", size, size, rectCount, probeCount, linearHits, gridNs, linearNs, sizeMismatches);
+        mismatches += sizeMismatches;
+
+        free(centers);
+        free(radii);
+        free(expected);
+        free(rects);
+        Maze_Destroy(maze);
+    }
+    return mismatches;
+}
+
+// Helper: Portal culling on mazes with loops. Each 24x24 maze (3-unit cells,
+// as in the game) gets 200 extra walls opened, then the culler gathers from
+// random eyes and headings plus one eye that used to cycle forever. Every
+// gather must finish without hitting the culler's push cap (four per cell).
+// Returns the number of gathers that did.
+static long long RunPortalCheck(uint64_t seed) {
+    static const int mazes = 50;
+    static const int eyesPerMaze = 2000;
+    const int size = 24;
+    long long capped = 0;
+    long long gathers = 0;
+    long long visits = 0;
+    int worstVisits = 0;
+    double seconds = 0.0;
+
+    for (int m = 0; m < mazes; m++) {
+        Maze* maze = Maze_Create(size, size, 3.0f);
+        VisibleSet* set = maze ? VisibleSet_Create(maze) : NULL;
+        PortalCuller* culler = maze ? PortalCuller_Create(maze) : NULL;
+        if (!maze || !set || !culler) {
+            fprintf(stderr, "Failed to allocate a %dx%d portal check\n", size, size);
+            PortalCuller_Destroy(culler);
+            VisibleSet_Destroy(set);
+            Maze_Destroy(maze);
+            return capped + 1;
+        }
+        Rng rng = Rng_ForStream(seed, RNG_STREAM_MAZE, 0x1007 + (uint64_t)m);
+        Maze_GenerateWith(maze, (MazeAlgorithm)(m % MAZE_ALGO_COUNT), &rng);
+        static const int dirs[4] = {MAZE_NORTH, MAZE_EAST, MAZE_SOUTH, MAZE_WEST};
+        for (int opened = 0; opened < 200;) {
+            int x = (int)Rng_Range(&rng, (uint32_t)size);
+            int y = (int)Rng_Range(&rng, (uint32_t)size);
+            int dir = dirs[Rng_Range(&rng, 4)];
+            if ((dir == MAZE_NORTH && y == 0) || (dir == MAZE_WEST && x == 0) ||
+                (dir == MAZE_SOUTH && y == size - 1) || (dir == MAZE_EAST && x == size - 1)) continue;
+            if (!Maze_HasWall(maze, x, y, dir)) continue;
+            Maze_RemoveWall(maze, x, y, dir);
+            opened++;
+        }
+
+        float half = size * 0.5f * maze->cellSize;
+        for (int i = 0; i < eyesPerMaze; i++) {
+            Vector3 eye = {-6.5f, 1.5f, -19.75f};
+            float yaw = 6.24f;
+            if (i > 0) {
+                eye.x = (Rng_Float(&rng) * 2.0f - 1.0f) * half * 0.999f;
+                eye.z = (Rng_Float(&rng) * 2.0f - 1.0f) * half * 0.999f;
+                yaw = Rng_Float(&rng) * 6.2831853f;
+            }
+            // Eyes on cell edges are the degenerate portal case
+            if (i % 4 == 1) eye.x = roundf(eye.x / maze->cellSize) * maze->cellSize;
+            Vector3 forward = {sinf(yaw), 0.0f, -cosf(yaw)};
+
+            double start = Now();
+            PortalCuller_Gather(culler, eye, forward, 75.0f, 16.0f / 9.0f, set);
+            seconds += Now() - start;
+            gathers++;
+            visits += culler->visited;
+            if (culler->visited > worstVisits) worstVisits = culler->visited;
+            if (culler->visited > 4 * size * size) capped++;
+        }
+
+        PortalCuller_Destroy(culler);
+        VisibleSet_Destroy(set);
+        Maze_Destroy(maze);
+    }
+
+    printf("portal %dx%d +200 loops: %lld gathers, %.1f visits avg, %d worst, %.2f us per gather, %lld capped\n",
+           size, size, gathers, (double)visits / gathers, worstVisits, seconds * 1e6 / gathers, capped);
+    return capped;
+}
+
+// Helper: Time one wall query per step, either at random cells or on a
+// random walk (each step moves to a neighbouring cell)
+static double BenchHasWall(const Maze* maze, int queries, uint64_t seed, bool walk) {
+    Rng rng = Rng_ForStream(seed, RNG_STREAM_MAZE, 0x3A11);
+    int x = maze->width / 2;
+    int y = maze->height / 2;
+    volatile int walls = 0;
+    double start = Now();
+    for (int i = 0; i < queries; i++) {
+        int dir = 1 << (Rng_Next(&rng) & 3);
+        if (walk) {
+            if (dir == MAZE_EAST && x + 1 < maze->width) x++;
+            if (dir == MAZE_WEST && x > 0) x--;
+            if (dir == MAZE_SOUTH && y + 1 < maze->height) y++;
+            if (dir == MAZE_NORTH && y > 0) y--;
+        } else {
+            x = (int)Rng_Range(&rng, (uint32_t)maze->width);
+            y = (int)Rng_Range(&rng, (uint32_t)maze->height);
+        }
+        walls += Maze_HasWall(maze, x, y, dir);
+    }
+    return (Now() - start) * 1e9 / queries;
+}
+
+// Helper: Write the maze as a compressed container, check it reads back
+// identically and compare its size and wall-query latency with the raw maze
+static bool BenchCompressed(const Maze* maze, const char* path, uint64_t seed, const char* layoutName) {
+    double start = Now();
+    bool saved = CompressedMaze_Save(maze, path);
+    double saveSeconds = Now() - start;
+    Maze* compressed = saved ? CompressedMaze_Open(path, 0) : NULL;
+    if (!compressed) {
+        printf("[%s] compressed: failed to write %s\n", layoutName, path);
+        return false;
+    }
+
+    bool same = true;
+    for (int y = 0; y < maze->height && same; y++) {
+        for (int x = 0; x < maze->width; x++) {
+            if (Maze_GetCell(compressed, x, y) != Maze_GetCell(maze, x, y)) same = false;
+        }
+    }
+
+    CompressedMazeStats stats = CompressedMaze_GetStats(compressed);
+    double cells = (double)maze->width * maze->height;
+    printf("[%s] compressed: %.1f MB in %.3f s, %.3f bits/cell, %.2fx smaller than packed, %.2fx than bytes, %s\n",
+           layoutName, stats.compressedBytes / (1024.0 * 1024.0), saveSeconds, stats.compressedBytes * 8.0 / cells,
+           (double)stats.rawBytes / stats.compressedBytes, cells / stats.compressedBytes,
+           same ? "identical" : "MISMATCH");
+
+    // Random queries nearly always decode a block, so they get fewer rounds
+    printf("[%s] HasWall random: %.0f ns raw, %.0f ns compressed; walk: %.1f ns raw, %.1f ns compressed\n",
+           layoutName, BenchHasWall(maze, 1000000, seed, false), BenchHasWall(compressed, 10000, seed, false),
+           BenchHasWall(maze, 1000000, seed, true), BenchHasWall(compressed, 1000000, seed, true));
+    Maze_Destroy(compressed);
+    return same;
+}
+
+// Helper: Minor and major page faults of this process so far, and its
+// peak resident set in KB
+static void PageFaults(long* outMinor, long* outMajor, long* outPeakKB) {
+#ifdef _WIN32
+    *outMinor = *outMajor = *outPeakKB = 0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    *outMinor = usage.ru_minflt;
+    *outMajor = usage.ru_majflt;
+    *outPeakKB = usage.ru_maxrss;
+#endif
+}
+
+// Helper: Out-of-core run: stream a maze to disk with Eller, then walk it
+// diagonally and query it at random through a bounded file window
+static int RunOutOfCore(const char* path, int width, int height, uint64_t seed, size_t windowBytes) {
+    const double cells = (double)width * height;
+    double start = Now();
+    if (!Maze_GenerateToFile(path, width, height, 1.0f, seed)) {
+        fprintf(stderr, "Failed to write %s\n", path);
+        return 1;
+    }
+    double seconds = Now() - start;
+    double fileMB = (MAZE_FILE_ALIGN + (double)MAZE_PACKED_STRIDE(width) * height) / (1024.0 * 1024.0);
+    printf("stream %dx%d (%.2f Gcells) to disk: %.1f s, %.1f Mcells/s, %.1f MB/s, file %.1f MB\n", width, height,
+           cells / 1e9, seconds, cells / seconds / 1e6, fileMB / seconds, fileMB);
+
+#ifndef _WIN32
+    // Start cold: drop the file from the page cache
+    int fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+#endif
+
+    Maze* maze = MazeWindow_Map(path, windowBytes);
+    if (!maze) return 1;
+
+    // Walk corner to corner a quarter cell per step, colliding at each step
+    long minor0, major0, minor1, major1, peakKB;
+    int steps = (width > height ? width : height) * 4;
+    int hits = 0;
+    PageFaults(&minor0, &major0, &peakKB);
+    start = Now();
+    for (int i = 0; i <= steps; i++) {
+        float t = (float)i / steps;
+        Vector2 p = {(t - 0.5f) * (width - 1), (t - 0.5f) * (height - 1)};
+        if (Maze_CollidesCircle(maze, p, 0.3f)) hits++;
+    }
+    seconds = Now() - start;
+    PageFaults(&minor1, &major1, &peakKB);
+    MazeWindowStats stats = MazeWindow_GetStats(maze);
+    printf("walk: %d queries in %.3f s (%.0f ns each, %d hits), %lld band maps, %ld minor / %ld major faults\n",
+           steps + 1, seconds, seconds * 1e9 / (steps + 1), hits, stats.remaps, minor1 - minor0, major1 - major0);
+
+    const int queries = 100000;
+    long long remaps = stats.remaps;
+    PageFaults(&minor0, &major0, &peakKB);
+    hits = BenchCollision(maze, queries, seed, &seconds);
+    PageFaults(&minor1, &major1, &peakKB);
+    stats = MazeWindow_GetStats(maze);
+    printf("random: %d queries in %.3f s (%.0f ns each, %d hits), %lld band maps, %ld minor / %ld major faults\n",
+           queries, seconds, seconds * 1e9 / queries, hits, stats.remaps - remaps, minor1 - minor0, major1 - major0);
+    printf("window: %d bands x %d rows (%.1f MB each), %d resident, peak RSS %.1f MB\n", MAZE_WINDOW_BANDS,
+           stats.bandRows, stats.bandBytes / (1024.0 * 1024.0), stats.resident, peakKB / 1024.0);
+
+    Maze_Destroy(maze);
+    return 0;
+}
+
+// Helper: Wall queries on a chunked maze through its default cache: a
+// random walk (the player's access pattern) and uniform random cells (every
+// query a likely miss)
+static int RunChunked(int width, int height, uint64_t seed, MazeAlgorithm algorithm) {
+    Maze* maze = ChunkedMaze_Create(width, height, 1.0f, seed, algorithm);
+    if (!maze) {
+        fprintf(stderr, "Failed to create a chunked %dx%d maze\n", width, height);
+        return 1;
+    }
+    long minor, major, peakKB;
+    double walkNs = BenchHasWall(maze, 10000000, seed, true);
+    ChunkCacheStats walk = ChunkedMaze_GetStats(maze);
+    double randomNs = BenchHasWall(maze, 100000, seed, false);
+    ChunkCacheStats all = ChunkedMaze_GetStats(maze);
+    PageFaults(&minor, &major, &peakKB);
+    printf("chunked %dx%d %s: walk %.1f ns (%lld chunks built), random %.0f ns (%lld built, %lld evicted), "
+           "%d resident, peak RSS %.1f MB\n", width, height, Maze_AlgorithmName(algorithm), walkNs, walk.generated,
+           randomNs, all.generated - walk.generated, all.evictions, all.resident, peakKB / 1024.0);
+    Maze_Destroy(maze);
+    return 0;
+}
+
+// Maze generation benchmark:
+//   mazebench [--size WxH] [--seed N] [--runs N] [--algo NAME|all] [--threads N|scale] [--tile N]
+//             [--layout bytes|packed|tiled|morton|all] [--save FILE]
+//             [--compressed FILE] [--out-of-core FILE [--window MB]] [--collision-check]
+//             [--portal-check] [--chunked]
+// With --threads the maze is carved in tiles on N threads; "scale" runs 1, 2,
+// 4, 8 and all hardware threads and reports the speedup over one thread.
+// Each layout is also timed on a full BFS (the chasers' flow field), on
+// collision queries and on the merged wall-run scan that feeds the
+// renderer's mesh build. --save writes the maze to FILE and times mapping
+// it back against generating it. --compressed writes the block-compressed
+// container to FILE and compares its size and query latency with the raw
+// maze. --out-of-core streams the maze to FILE
+// instead and measures paging while walking it through a bounded window.
+// --collision-check times Maze_CollidesCircle against a linear scan over
+// every wall from 15x15 to 2000x2000 and fails if any answer differs.
+// --chunked times wall queries on a ChunkedMaze of the given size, which
+// holds only its chunk cache in memory.
+// --portal-check runs the portal culler on small mazes with loops and fails
+// if any gather has to be cut short.
+
+int main(int argc, char** argv) {
+    int width = 10000;
+    int height = 10000;
+    uint64_t seed = 1;
+    int runs = 1;
+    int firstAlgo = 0;
+    int lastAlgo = MAZE_ALGO_COUNT - 1;
+    int threadCounts[5] = {0};     // 0 = plain single-threaded generator
+    int threadRuns = 1;
+    int tileSize = MAZE_PARALLEL_TILE;
+    int firstLayout = MAZE_STORAGE_BYTES;
+    int lastLayout = MAZE_STORAGE_BYTES;
+    const char* savePath = NULL;
+    const char* compressedPath = NULL;
+    const char* outOfCorePath = NULL;
+    size_t windowBytes = (size_t)64 << 20;
+    bool collisionCheck = false;
+    bool portalCheck = false;
+    bool chunked = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%dx%d", &width, &height) != 2 || width < 1 || height < 1) {
+                fprintf(stderr, "Invalid --size, expected WxH\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = atoi(argv[++i]);
+            if (runs < 1) runs = 1;
+        } else if (strcmp(argv[i], "--algo") == 0 && i + 1 < argc) {
+            MazeAlgorithm algorithm;
+            if (strcmp(argv[++i], "all") == 0) continue;
+            if (!Maze_AlgorithmFromName(argv[i], &algorithm)) {
+                fprintf(stderr, "Unknown algorithm '%s'\n", argv[i]);
+                return 1;
+            }
+            firstAlgo = lastAlgo = (int)algorithm;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            if (strcmp(argv[++i], "scale") == 0) {
+                int hw = Maze_HardwareThreads();
+                int counts[4] = {1, 2, 4, 8};
+                threadRuns = 0;
+                for (int k = 0; k < 4 && counts[k] < hw; k++) threadCounts[threadRuns++] = counts[k];
+                threadCounts[threadRuns++] = hw;
+            } else {
+                threadCounts[0] = atoi(argv[i]) > 0 ? atoi(argv[i]) : Maze_HardwareThreads();
+                threadRuns = 1;
+            }
+        } else if (strcmp(argv[i], "--tile") == 0 && i + 1 < argc) {
+            tileSize = atoi(argv[++i]);
+            if (tileSize < 1) tileSize = MAZE_PARALLEL_TILE;
+        } else if (strcmp(argv[i], "--layout") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "all") == 0) {
+                firstLayout = MAZE_STORAGE_BYTES;
+                lastLayout = MAZE_STORAGE_MORTON;
+                continue;
+            }
+            firstLayout = -1;
+            for (int k = 0; k <= MAZE_STORAGE_MORTON; k++) {
+                if (strcmp(argv[i], s_layoutNames[k]) == 0) firstLayout = lastLayout = k;
+            }
+            if (firstLayout < 0) {
+                fprintf(stderr, "Unknown layout '%s'\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--save") == 0 && i + 1 < argc) {
+            savePath = argv[++i];
+        } else if (strcmp(argv[i], "--compressed") == 0 && i + 1 < argc) {
+            compressedPath = argv[++i];
+        } else if (strcmp(argv[i], "--out-of-core") == 0 && i + 1 < argc) {
+            outOfCorePath = argv[++i];
+        } else if (strcmp(argv[i], "--window") == 0 && i + 1 < argc) {
+            windowBytes = (size_t)strtoull(argv[++i], NULL, 0) << 20;
+        } else if (strcmp(argv[i], "--collision-check") == 0) {
+            collisionCheck = true;
+        } else if (strcmp(argv[i], "--portal-check") == 0) {
+            portalCheck = true;
+        } else if (strcmp(argv[i], "--chunked") == 0) {
+            chunked = true;
+        } else {
+            fprintf(stderr, "Usage: %s [--size WxH] [--seed N] [--runs N] [--algo NAME|all] "
+                    "[--threads N|scale] [--tile N] [--layout NAME|all] [--save FILE] "
+                    "[--compressed FILE] [--out-of-core FILE [--window MB]] [--collision-check] [--portal-check] [--chunked]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    if (outOfCorePath) return RunOutOfCore(outOfCorePath, width, height, seed, windowBytes);
+    if (collisionCheck) return RunCollisionCheck(seed) == 0 ? 0 : 1;
+    if (portalCheck) return RunPortalCheck(seed) == 0 ? 0 : 1;
+    if (chunked) return RunChunked(width, height, seed, (MazeAlgorithm)firstAlgo);
+
+    const double cells = (double)width * height;
+    bool allPerfect = true;
+    for (int layout = firstLayout; layout <= lastLayout; layout++) {
+        const char* layoutName = s_layoutNames[layout];
+        Maze* maze = Maze_CreateEx(width, height, 1.0f, (MazeStorage)layout);
+        if (!maze) {
+            fprintf(stderr, "Failed to allocate %dx%d %s maze\n", width, height, layoutName);
+            return 1;
+        }
+
+        for (int algo = firstAlgo; algo <= lastAlgo; algo++) {
+            const char* name = Maze_AlgorithmName((MazeAlgorithm)algo);
+            double baseline = 0.0;
+            for (int t = 0; t < threadRuns; t++) {
+                int threads = threadCounts[t];
+                double best = 0.0;
+                for (int r = 0; r < runs; r++) {
+                    Rng rng = Rng_ForStream(seed, RNG_STREAM_MAZE, (uint64_t)r);
+                    double start = Now();
+                    if (threads > 0) {
+                        Maze_GenerateParallel(maze, (MazeAlgorithm)algo, &rng, threads, tileSize);
+                    } else {
+                        Maze_GenerateWith(maze, (MazeAlgorithm)algo, &rng);
+                    }
+                    double seconds = Now() - start;
+                    if (seconds > 0.0 && cells / seconds > best) best = cells / seconds;
+                    printf("[%s] %s x%d run %d: %.3f s (%.1f Mcells/s)\n", layoutName, name,
+                           threads > 0 ? threads : 1, r + 1, seconds, seconds > 0.0 ? cells / seconds / 1e6 : 0.0);
+                }
+                if (t == 0) baseline = best;
+
+                bool perfect = Maze_IsPerfect(maze);
+                allPerfect = allPerfect && perfect;
+                printf("[%s] %s %dx%d x%d: best %.1f Mcells/s (%.2fx), %s\n", layoutName, name, width, height,
+                       threads > 0 ? threads : 1, best / 1e6, baseline > 0.0 ? best / baseline : 0.0,
+                       perfect ? "spanning tree" : "NOT a spanning tree");
+            }
+        }
+
+        // Queries on the last generated maze
+        double seconds;
+        FlowField* field = FlowField_Create(maze);
+        if (field) {
+            double start = Now();
+            FlowField_Build(field, maze, width / 2, height / 2);
+            seconds = Now() - start;
+            printf("[%s] bfs: %.3f s (%.1f Mcells/s)\n", layoutName, seconds,
+                   seconds > 0.0 ? cells / seconds / 1e6 : 0.0);
+            FlowField_Destroy(field);
+        }
+
+        const int queries = 1000000;
+        int hits = BenchCollision(maze, queries, seed, &seconds);
+        printf("[%s] collision: %d queries in %.3f s (%.1f ns each, %d hits)\n", layoutName, queries,
+               seconds, seconds * 1e9 / queries, hits);
+
+        size_t maxRects = (size_t)width * height * 2 + width + height;
+        WallRect* rects = (WallRect*)malloc(maxRects * sizeof(WallRect));
+        if (rects && maxRects <= 0x7FFFFFFF) {
+            double start = Now();
+            int runCount = Maze_GetMergedWallRects(maze, rects, (int)maxRects);
+            seconds = Now() - start;
+            printf("[%s] wall runs for the mesh: %d in %.3f s (%.1f Mcells/s)\n", layoutName, runCount,
+                   seconds, seconds > 0.0 ? cells / seconds / 1e6 : 0.0);
+        } else {
+            printf("[%s] wall runs skipped: no memory for %zu rects\n", layoutName, maxRects);
+        }
+        free(rects);
+
+        if (savePath) {
+            double start = Now();
+            bool saved = Maze_Save(maze, savePath);
+            double saveSeconds = Now() - start;
+
+            start = Now();
+            Maze* mapped = saved ? Maze_Map(savePath) : NULL;
+            double mapSeconds = Now() - start;
+
+            // Touch every cell so the whole file is paged in
+            start = Now();
+            unsigned int sum = 0;
+            for (int y = 0; mapped && y < height; y++) {
+                for (int x = 0; x < width; x++) sum += Maze_GetCell(mapped, x, y);
+            }
+            double touchSeconds = Now() - start;
+
+            bool same = mapped && memcmp(mapped->cells ? mapped->cells : mapped->edges,
+                                         maze->cells ? maze->cells : maze->edges, Maze_StorageSize(maze)) == 0;
+            allPerfect = allPerfect && same;
+            printf("[%s] file: save %.3f s, map %.6f s, read every cell %.3f s (sum %u), %s\n", layoutName,
+                   saveSeconds, mapSeconds, touchSeconds, sum, same ? "identical" : "MISMATCH");
+            Maze_Unmap(mapped);
+        }
+        if (compressedPath) allPerfect = BenchCompressed(maze, compressedPath, seed, layoutName) && allPerfect;
+
+        // Scratch on top of this: backtracker cells/4 bytes, Eller 15 bytes per
+        // column, Kruskal 12 bytes per cell, Wilson none (the non-streaming
+        // algorithms also borrow a byte maze while generating a packed one)
+        double storage = (double)Maze_StorageSize(maze);
+        printf("[%s] maze storage %.1f MB\n", layoutName, storage / (1024.0 * 1024.0));
+
+        Maze_Destroy(maze);
+    }
+    return allPerfect ? 0 : 1;
+}